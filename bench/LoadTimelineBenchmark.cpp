@@ -0,0 +1,1252 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QGridLayout>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMouseEvent>
+#include <QProcess>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimeZone>
+#include <QtEndian>
+
+#include "widget/LoadAnnotationIndex.h"
+#include "widget/LoadBackgroundCache.h"
+#include "widget/LoadClock.h"
+#include "widget/LoadFrameScheduler.h"
+#include "widget/LoadMappingKernel.h"
+#include "widget/LoadReplayEngine.h"
+#include "widget/LoadSessionArchive.h"
+#include "widget/LoadSignalPipeline.h"
+#include "widget/LoadStreamParser.h"
+#include "widget/LoadTimelineModel.h"
+#include "widget/LoadTimelineWidget.h"
+#include "widget/LoadWindowExtrema.h"
+#include "widget/LoadZoneStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+// 无界面性能基准：在 offscreen 平台下把控件渲染到 QImage，
+// 统计不同样本量、时间窗口、平滑开关与 DPR 下的单帧耗时，以及追加/批量设置/裁剪吞吐。
+// 每项结果输出一行 JSON，便于脚本收集并跟踪回归。
+
+namespace {
+
+QTextStream &out() {
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+void report(const QJsonObject &result) {
+    out() << QJsonDocument(result).toJson(QJsonDocument::Compact) << '\n';
+    out().flush();
+}
+
+QList<int> parseIntList(const QString &text) {
+    QList<int> values;
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const int value = part.trimmed().toInt(&ok);
+        if (ok && value > 0) values.append(value);
+    }
+    return values;
+}
+
+// 在 [now - windowSeconds, now] 内均匀生成 count 个样本
+QVector<LoadTimelineWidget::Sample> makeSamples(int count, int windowSeconds, qint64 nowMs) {
+    QVector<LoadTimelineWidget::Sample> samples;
+    samples.reserve(count);
+    const double stepMs = windowSeconds * 1000.0 / qMax(1, count);
+    QRandomGenerator random(42);
+    for (int i = 0; i < count; ++i) {
+        LoadTimelineWidget::Sample sample;
+        sample.timestamp = QDateTime::fromMSecsSinceEpoch(nowMs - qint64((count - i) * stepMs), QTimeZone::UTC);
+        sample.loadValue = random.bounded(100.0);
+        samples.append(sample);
+    }
+    return samples;
+}
+
+// 基准与校验共用的控件：800×300、不限帧率，时间源为虚拟时钟（固定“当前时刻”，每帧绘制相同内容，结果可复现）。
+// 多个控件可共用同一个时钟
+struct BenchWidget {
+    explicit BenchWidget(int windowSeconds, std::shared_ptr<LoadVirtualClock> sharedClock = nullptr, qreal dpr = 1.0)
+        : clock(sharedClock ? std::move(sharedClock)
+                            : std::make_shared<LoadVirtualClock>(QDateTime::currentMSecsSinceEpoch())),
+          image(QSize(800, 300) * dpr, QImage::Format_ARGB32_Premultiplied) {
+        widget.resize(800, 300);
+        widget.setMaxFrameRate(0);
+        widget.setClock(clock);
+        widget.setTimeWindowSeconds(windowSeconds);
+        image.setDevicePixelRatio(dpr);
+    }
+
+    void render() {
+        image.fill(Qt::transparent);
+        widget.render(&image);
+    }
+
+    // 预热 3 帧（生成背景与曲线缓存）后至少绘制 minFrames 帧且不少于 200 ms，返回单帧耗时
+    double nsPerFrame(int minFrames, int *framesOut = nullptr) {
+        for (int i = 0; i < 3; ++i) {
+            widget.render(&image);
+        }
+        QElapsedTimer timer;
+        timer.start();
+        int frames = 0;
+        while (frames < minFrames || timer.elapsed() < 200) {
+            widget.render(&image);
+            ++frames;
+        }
+        if (framesOut) *framesOut = frames;
+        return double(timer.nsecsElapsed()) / frames;
+    }
+
+    std::shared_ptr<LoadVirtualClock> clock;
+    LoadTimelineWidget widget;
+    QImage image;
+};
+
+void benchRender(const QList<int> &sampleCounts, const QList<int> &windows, int minFrames, qreal dpr) {
+    BenchWidget bench(windows.value(0, 60), nullptr, dpr);
+    for (int window : windows) {
+        bench.widget.setTimeWindowSeconds(window);
+        for (int count : sampleCounts) {
+            bench.widget.setSamples(makeSamples(count, window, bench.clock->nowMs()));
+            for (bool smoothing : {false, true}) {
+                for (bool scrollBlit : {false, true}) {
+                    bench.widget.setSmoothingEnabled(smoothing);
+                    bench.widget.setScrollBlitEnabled(scrollBlit);
+
+                    int frames = 0;
+                    const double nsPerFrame = bench.nsPerFrame(minFrames, &frames);
+
+                    QJsonObject result;
+                    result["bench"] = QStringLiteral("render");
+                    result["samples"] = count;
+                    result["windowSeconds"] = window;
+                    result["smoothing"] = smoothing;
+                    result["scrollBlit"] = scrollBlit;
+                    result["dpr"] = dpr;
+                    result["frames"] = frames;
+                    result["nsPerFrame"] = nsPerFrame;
+                    report(result);
+                }
+            }
+        }
+    }
+}
+
+void benchIngest(const QList<int> &sampleCounts, const QList<int> &windows) {
+    for (int window : windows) {
+        for (int count : sampleCounts) {
+            const QVector<LoadTimelineWidget::Sample> samples = makeSamples(count, window, QDateTime::currentMSecsSinceEpoch());
+            QElapsedTimer timer;
+
+            // 逐个追加
+            {
+                LoadTimelineWidget widget;
+                widget.setTimeWindowSeconds(window);
+                timer.start();
+                for (const LoadTimelineWidget::Sample &sample : samples) {
+                    widget.appendSample(sample);
+                }
+                const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+                QJsonObject result;
+                result["bench"] = QStringLiteral("appendSample");
+                result["samples"] = count;
+                result["windowSeconds"] = window;
+                result["samplesPerSecond"] = count * 1e9 / elapsedNs;
+                report(result);
+            }
+
+            // 批量追加
+            {
+                LoadTimelineWidget widget;
+                widget.setTimeWindowSeconds(window);
+                timer.start();
+                widget.appendSamples(samples);
+                const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+                QJsonObject result;
+                result["bench"] = QStringLiteral("appendSamples");
+                result["samples"] = count;
+                result["windowSeconds"] = window;
+                result["samplesPerSecond"] = count * 1e9 / elapsedNs;
+                report(result);
+            }
+
+            // 整体替换
+            {
+                LoadTimelineWidget widget;
+                widget.setTimeWindowSeconds(window);
+                timer.start();
+                widget.setSamples(samples);
+                const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+                QJsonObject result;
+                result["bench"] = QStringLiteral("setSamples");
+                result["samples"] = count;
+                result["windowSeconds"] = window;
+                result["nsPerCall"] = double(elapsedNs);
+                result["samplesPerSecond"] = count * 1e9 / elapsedNs;
+                report(result);
+            }
+
+            // 裁剪：数据覆盖两倍窗口，缩小窗口时裁掉前一半
+            {
+                LoadTimelineWidget widget;
+                widget.setTimeWindowSeconds(window * 2);
+                widget.setSamples(makeSamples(count, window * 2, QDateTime::currentMSecsSinceEpoch()));
+                const qsizetype before = widget.samples().size();
+                timer.start();
+                widget.setTimeWindowSeconds(window);
+                const qint64 elapsedNs = timer.nsecsElapsed();
+                const qsizetype pruned = qMax<qsizetype>(1, before - widget.samples().size());
+                QJsonObject result;
+                result["bench"] = QStringLiteral("prune");
+                result["samples"] = count;
+                result["windowSeconds"] = window;
+                result["pruned"] = qint64(pruned);
+                result["nsPerCall"] = double(elapsedNs);
+                result["nsPerPrunedSample"] = double(elapsedNs) / pruned;
+                report(result);
+            }
+        }
+    }
+}
+
+// 映射内核：逐个指令集统计吞吐
+void benchMapping(const QList<int> &sampleCounts, const QList<int> &windows) {
+    const QRectF area(20, 20, 760, 260);
+    for (int window : windows) {
+        for (int count : sampleCounts) {
+            const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+            const QVector<LoadTimelineWidget::Sample> samples = makeSamples(count, window, nowMs);
+            QVector<qint64> times(count);
+            QVector<double> values(count);
+            for (int i = 0; i < count; ++i) {
+                times[i] = samples.at(i).timestamp.toMSecsSinceEpoch();
+                values[i] = samples.at(i).loadValue;
+            }
+            QVector<QPointF> points(count);
+            const LoadMappingKernel::Transform transform =
+                LoadMappingKernel::makeTransform(double(nowMs), window, 0.0, 100.0, area);
+
+            for (LoadMappingKernel::Isa isa : {LoadMappingKernel::ScalarIsa, LoadMappingKernel::Sse2Isa,
+                                               LoadMappingKernel::Avx2Isa}) {
+                if (!LoadMappingKernel::isSupported(isa)) continue;
+                QElapsedTimer timer;
+                timer.start();
+                qint64 mapped = 0;
+                while (timer.elapsed() < 100) {
+                    LoadMappingKernel::mapWith(isa, transform, times.constData(), values.constData(), count,
+                                               points.data());
+                    mapped += count;
+                }
+                const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+                QJsonObject result;
+                result["bench"] = QStringLiteral("mapping");
+                result["isa"] = QLatin1String(LoadMappingKernel::isaName(isa));
+                result["samples"] = count;
+                result["windowSeconds"] = window;
+                result["nsPerSample"] = double(elapsedNs) / qMax<qint64>(1, mapped);
+                report(result);
+            }
+        }
+    }
+}
+
+// 信号调理：250 Hz 输入经完整管线后写入控件，统计每输入样本耗时与存储点数比例
+void benchPipeline(const QList<int> &sampleCounts) {
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    LoadSignalPipeline pipeline;
+    pipeline.addOutlierRejection(4.0);
+    pipeline.addMedian(5);
+    pipeline.addEma(100.0);
+    pipeline.addDownsample(40);
+
+    for (int count : sampleCounts) {
+        QVector<qint64> times(count);
+        QVector<double> values(count);
+        QRandomGenerator random(11);
+        for (int i = 0; i < count; ++i) {
+            times[i] = nowMs - qint64(count - i) * 4;
+            values[i] = 50.0 + 20.0 * std::sin(i * 0.01) + random.bounded(10.0) + (i % 500 == 0 ? 400.0 : 0.0);
+        }
+
+        LoadTimelineWidget widget;
+        widget.setTimeWindowSeconds(qMax(60, count / 250 + 1));
+        widget.setIngestPipeline(LoadTimelineWidget::PrimarySeriesId, pipeline);
+        QElapsedTimer timer;
+        timer.start();
+        widget.appendSeriesSamples(LoadTimelineWidget::PrimarySeriesId, times.constData(), values.constData(), count);
+        const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+        const LoadSignalPipeline result = widget.ingestPipeline();
+        QJsonObject json;
+        json["bench"] = QStringLiteral("pipeline");
+        json["samples"] = count;
+        json["nsPerSample"] = double(elapsedNs) / count;
+        json["storedRatio"] = double(widget.samples().size()) / count;
+        json["rejected"] = qint64(result.rejectedCount());
+        report(json);
+    }
+}
+
+// 分层保留：4 小时时间窗口、50 Hz 输入，比较全量原始样本与仅保留最近 5 分钟原始样本（其余汇总）时的
+// 内存占用、接入耗时与单帧耗时
+void benchRetention(int minFrames) {
+    constexpr int kWindowSeconds = 4 * 3600;
+    constexpr int kRate = 50;
+    for (const int rawSeconds : {0, 300}) {
+        BenchWidget bench(kWindowSeconds);
+        LoadTimelineWidget &widget = bench.widget;
+        const std::shared_ptr<LoadVirtualClock> &clock = bench.clock;
+        widget.setRawRetentionSeconds(rawSeconds);
+
+        QVector<qint64> times(kRate);
+        QVector<double> values(kRate);
+        QRandomGenerator random(13);
+        qint64 elapsedNs = 0;
+        for (int second = 0; second < kWindowSeconds; ++second) {
+            for (int i = 0; i < kRate; ++i) {
+                times[i] = clock->nowMs() + i * (1000 / kRate);
+                values[i] = 50.0 + 30.0 * std::sin((second * kRate + i) * 1e-4) + random.bounded(10.0);
+            }
+            clock->advance(1000);
+            QElapsedTimer timer;
+            timer.start();
+            widget.appendSeriesSamples(LoadTimelineWidget::PrimarySeriesId, times.constData(), values.constData(), kRate);
+            elapsedNs += timer.nsecsElapsed();
+        }
+        const double nsPerFrame = bench.nsPerFrame(minFrames);
+
+        QJsonObject json;
+        json["bench"] = QStringLiteral("retention");
+        json["windowSeconds"] = kWindowSeconds;
+        json["rawRetentionSeconds"] = rawSeconds;
+        json["samples"] = kWindowSeconds * kRate;
+        json["memoryBytes"] = widget.memoryUsageBytes();
+        json["nsPerSample"] = double(elapsedNs) / (qint64(kWindowSeconds) * kRate);
+        json["nsPerFrame"] = nsPerFrame;
+        report(json);
+    }
+}
+
+// 悬停检视：15 万样本的窗口中沿图表横向移动光标，统计每次移动的查找耗时与叠加层局部重绘耗时
+void benchHover(int minFrames) {
+    constexpr int kSamples = 150000;
+    BenchWidget bench(60);
+    LoadTimelineWidget &widget = bench.widget;
+    QImage &image = bench.image;
+    widget.setSamples(makeSamples(kSamples, 60, bench.clock->nowMs()));
+    widget.render(&image);
+    auto moveTo = [&](const QPointF &position) {
+        QMouseEvent move(QEvent::MouseMove, position, position, Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(&widget, &move);
+    };
+    // 首次悬停整帧绘制一次，建立帧缓存
+    moveTo(QPointF(400, 150));
+    widget.render(&image);
+
+    const int moves = qMax(minFrames, 2000);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < moves; ++i) {
+        moveTo(QPointF(60 + i % 700, 60 + (i * 7) % 180));
+    }
+    const qint64 lookupNs = timer.nsecsElapsed();
+
+    // 局部重绘：以十字线两条细带与提示框大小的矩形近似叠加层脏区域
+    timer.restart();
+    for (int i = 0; i < moves; ++i) {
+        const int x = 60 + i % 700;
+        const int y = 60 + (i * 7) % 180;
+        moveTo(QPointF(x, y));
+        QRegion dirty(QRect(x - 4, 0, 8, widget.height()));
+        dirty += QRect(0, y - 4, widget.width(), 8);
+        dirty += QRect(x + 10, y + 10, 200, 70);
+        widget.render(&image, QPoint(), dirty);
+    }
+    const qint64 repaintNs = timer.nsecsElapsed();
+
+    QJsonObject json;
+    json["bench"] = QStringLiteral("hover");
+    json["samples"] = kSamples;
+    json["moves"] = moves;
+    json["nsPerLookup"] = double(lookupNs) / moves;
+    json["nsPerOverlayRepaint"] = double(repaintNs) / moves;
+    report(json);
+}
+
+// 标注层：窗口内 0/1000/10000 个标注（点事件与区间各半）时的单帧耗时与添加耗时
+void benchAnnotations(int minFrames) {
+    for (const int count : {0, 1000, 10000}) {
+        BenchWidget bench(60);
+        LoadTimelineWidget &widget = bench.widget;
+        widget.setSamples(makeSamples(6000, 60, bench.clock->nowMs()));
+
+        const QColor colors[] = {QColor(94, 53, 177), QColor(0, 137, 123), QColor(230, 81, 0)};
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < count; ++i) {
+            const qint64 startMs = bench.clock->nowMs() - 60000 + qint64(i) * 60000 / qMax(1, count);
+            const QDateTime start = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::UTC);
+            if (i % 2 == 0) {
+                widget.addAnnotation(start, QStringLiteral("事件 %1").arg(i), colors[i % 3]);
+            } else {
+                widget.addAnnotation(start, start.addMSecs(1500), QStringLiteral("阶段 %1").arg(i), colors[i % 3]);
+            }
+        }
+        const qint64 insertNs = timer.nsecsElapsed();
+        const double nsPerFrame = bench.nsPerFrame(minFrames);
+
+        QJsonObject json;
+        json["bench"] = QStringLiteral("annotations");
+        json["annotations"] = count;
+        json["nsPerInsert"] = count > 0 ? double(insertNs) / count : 0.0;
+        json["nsPerFrame"] = nsPerFrame;
+        report(json);
+    }
+}
+
+// 共享数据模型：三个不同时间窗口的视图共用一个模型与各自持有模型，比较接入耗时、存储占用与单帧耗时
+void benchSharedModel(int minFrames) {
+    const int windows[] = {15, 60, 300};
+    const qsizetype batch = 1000;
+    const int batches = 60;
+    for (const bool shared : {false, true}) {
+        const auto clock = std::make_shared<LoadVirtualClock>(QDateTime::currentMSecsSinceEpoch());
+        LoadTimelineModel model;
+        model.setClock(clock);
+        std::vector<std::unique_ptr<BenchWidget>> views;
+        std::vector<LoadTimelineWidget *> widgets;
+        for (const int window : windows) {
+            auto view = std::make_unique<BenchWidget>(window, clock);
+            if (shared) {
+                view->widget.setModel(&model);
+                view->widget.setTimeWindowSeconds(window);
+            }
+            widgets.push_back(&view->widget);
+            views.push_back(std::move(view));
+        }
+
+        QVector<qint64> times(batch);
+        QVector<double> values(batch);
+        QElapsedTimer timer;
+        qint64 ingestNs = 0;
+        for (int b = 0; b < batches; ++b) {
+            const qint64 baseMs = clock->nowMs();
+            for (qsizetype i = 0; i < batch; ++i) {
+                times[i] = baseMs + i;
+                values[i] = 50.0 + 40.0 * std::sin((b * batch + i) * 0.001);
+            }
+            clock->advance(batch);
+            timer.restart();
+            if (shared) {
+                model.appendSamples(LoadTimelineModel::PrimarySeriesId, times.constData(), values.constData(), batch);
+            } else {
+                for (LoadTimelineWidget *widget : widgets) {
+                    widget->appendSeriesSamples(LoadTimelineWidget::PrimarySeriesId, times.constData(),
+                                                values.constData(), batch);
+                }
+            }
+            ingestNs += timer.nsecsElapsed();
+        }
+
+        qint64 memoryBytes = shared ? model.memoryUsageBytes() : 0;
+        if (!shared) {
+            for (LoadTimelineWidget *widget : widgets) memoryBytes += widget->memoryUsageBytes();
+        }
+
+        QImage &image = views.front()->image;
+        for (LoadTimelineWidget *widget : widgets) widget->render(&image);
+        timer.restart();
+        int frames = 0;
+        while (frames < minFrames || timer.elapsed() < 200) {
+            for (LoadTimelineWidget *widget : widgets) widget->render(&image);
+            ++frames;
+        }
+
+        QJsonObject json;
+        json["bench"] = QStringLiteral("sharedModel");
+        json["shared"] = shared;
+        json["views"] = static_cast<int>(widgets.size());
+        json["nsPerSample"] = double(ingestNs) / (qint64(batch) * batches);
+        json["memoryBytes"] = double(memoryBytes);
+        json["nsPerFrame"] = double(timer.nsecsElapsed()) / frames;
+        report(json);
+    }
+}
+
+// 流式解析：CSV 与二进制记录在内存缓冲上的解析吞吐
+void benchParse(const QList<int> &sampleCounts) {
+    for (int count : sampleCounts) {
+        const QVector<LoadTimelineWidget::Sample> samples = makeSamples(count, 60, QDateTime::currentMSecsSinceEpoch());
+        QByteArray csv;
+        QByteArray binary;
+        binary.reserve(count * LoadBinaryParser::RecordBytes);
+        for (const LoadTimelineWidget::Sample &sample : samples) {
+            const qint64 timeMs = sample.timestamp.toMSecsSinceEpoch();
+            csv += QByteArray::number(timeMs) + ',' + QByteArray::number(sample.loadValue, 'f', 3) + '\n';
+            char record[LoadBinaryParser::RecordBytes];
+            qToLittleEndian<qint64>(timeMs, record);
+            quint64 valueBits;
+            std::memcpy(&valueBits, &sample.loadValue, sizeof(valueBits));
+            qToLittleEndian<quint64>(valueBits, record + 8);
+            binary.append(record, sizeof(record));
+        }
+
+        for (const bool isCsv : {true, false}) {
+            const QByteArray &input = isCsv ? csv : binary;
+            double checksum = 0.0;
+            auto sink = [&checksum](qint64 timeMs, double value) { checksum += value + double(timeMs & 1); };
+            QElapsedTimer timer;
+            timer.start();
+            qint64 bytes = 0;
+            qint64 parsed = 0;
+            while (timer.elapsed() < 100) {
+                LoadCsvParser csvParser;
+                LoadBinaryParser binaryParser;
+                bytes += isCsv ? csvParser.parse(input.constData(), input.size(), sink)
+                               : binaryParser.parse(input.constData(), input.size(), sink);
+                parsed += count;
+            }
+            const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+            QJsonObject result;
+            result["bench"] = QStringLiteral("parse");
+            result["format"] = isCsv ? QStringLiteral("csv") : QStringLiteral("binary");
+            result["samples"] = count;
+            result["megabytesPerSecond"] = bytes * 1e3 / elapsedNs;
+            result["samplesPerSecond"] = parsed * 1e9 / elapsedNs;
+            result["checksum"] = checksum;
+            report(result);
+        }
+    }
+}
+
+// 仪表盘：64 个同尺寸控件排成网格，每拍只向其中 changed 个追加样本，
+// 统计每拍派发的重绘数与每拍耗时（应随变化的控件数增长，而与控件总数无关）
+void benchDashboard(int rounds) {
+    constexpr int kRows = 8;
+    constexpr int kColumns = 8;
+    QWidget window;
+    auto *layout = new QGridLayout(&window);
+    QList<LoadTimelineWidget *> widgets;
+    for (int i = 0; i < kRows * kColumns; ++i) {
+        auto *widget = new LoadTimelineWidget(&window);
+        widget->setMinimumSize(200, 180);
+        layout->addWidget(widget, i / kColumns, i % kColumns);
+        widgets.append(widget);
+    }
+    window.show();
+    QCoreApplication::processEvents();
+
+    LoadFrameScheduler *scheduler = LoadFrameScheduler::instance();
+    // 提高节拍帧率，缩短每拍的等待时间，耗时以绘制为主
+    scheduler->setFrameRate(1000.0);
+    QRandomGenerator random(3);
+    for (const int changed : {0, 1, 8, kRows * kColumns}) {
+        const quint64 dispatchedMark = scheduler->dispatchedFrames();
+        QElapsedTimer timer;
+        timer.start();
+        for (int round = 0; round < rounds; ++round) {
+            const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+            for (int i = 0; i < changed; ++i) {
+                widgets[i]->appendSample({QDateTime::fromMSecsSinceEpoch(nowMs, QTimeZone::UTC), random.bounded(100.0)});
+            }
+            // 等待下一拍派发，再处理本拍产生的绘制请求
+            const quint64 tickMark = scheduler->tickCount();
+            QElapsedTimer wait;
+            wait.start();
+            while (scheduler->tickCount() == tickMark && changed > 0 && wait.elapsed() < 50) {
+                QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+            }
+            QCoreApplication::processEvents();
+        }
+        const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+        QJsonObject result;
+        result["bench"] = QStringLiteral("dashboard");
+        result["widgets"] = kRows * kColumns;
+        result["changedWidgets"] = changed;
+        result["rounds"] = rounds;
+        result["framesPerRound"] = double(scheduler->dispatchedFrames() - dispatchedMark) / rounds;
+        result["nsPerRound"] = double(elapsedNs) / rounds;
+        result["sharedBackgrounds"] = qint64(LoadBackgroundCache::entryCount());
+        report(result);
+    }
+    scheduler->setFrameRate(0.0);
+}
+
+// 校验：各 SIMD 实现与标量实现逐点比较（含越界、NaN 与 ±∞ 负荷值，以及 1~7 个样本的尾部长度），返回是否全部一致
+bool verifyMapping() {
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const int window = 60;
+    const QRectF area(12.5, 18.0, 801.0, 277.5);
+    QRandomGenerator random(7);
+
+    // 奇数长度覆盖尾部标量处理；时间覆盖窗口两侧，负荷值覆盖量程两侧
+    const int count = 4099;
+    QVector<qint64> times(count);
+    QVector<double> values(count);
+    for (int i = 0; i < count; ++i) {
+        times[i] = nowMs - 2 * window * 1000 + qint64(random.bounded(3 * window * 1000));
+        values[i] = random.bounded(140.0) - 20.0;
+    }
+    // 非有限值放在短数组也能覆盖到的前几个位置，以及向量主体中
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    for (const int i : {1, 6, count / 2}) values[i] = nan;
+    for (const int i : {2, count / 3}) values[i] = inf;
+    for (const int i : {4, count - 2}) values[i] = -inf;
+
+    // 两个坐标相同：同为 NaN、相等（含同号无穷）或误差不超过容差
+    auto same = [](double a, double b) {
+        if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+        return a == b || qAbs(a - b) <= 1e-9;
+    };
+
+    bool allMatch = true;
+    for (double fraction : {0.0, 0.25, 0.999}) {
+        const LoadMappingKernel::Transform transform =
+            LoadMappingKernel::makeTransform(nowMs + fraction, window, 0.0, 100.0, area);
+
+        for (LoadMappingKernel::Isa isa : {LoadMappingKernel::Sse2Isa, LoadMappingKernel::Avx2Isa}) {
+            if (!LoadMappingKernel::isSupported(isa)) continue;
+            // 长度 1~7 只经过尾部处理（或一个向量加尾部），起点偏移 1 覆盖未对齐的输入
+            int cases = 0;
+            int mismatches = 0;
+            for (const int length : {1, 2, 3, 4, 5, 6, 7, count - 1}) {
+                for (const int offset : {0, 1}) {
+                    QVector<QPointF> expected(length);
+                    QVector<QPointF> actual(length);
+                    LoadMappingKernel::mapWith(LoadMappingKernel::ScalarIsa, transform, times.constData() + offset,
+                                               values.constData() + offset, length, expected.data());
+                    LoadMappingKernel::mapWith(isa, transform, times.constData() + offset, values.constData() + offset,
+                                               length, actual.data());
+                    for (int i = 0; i < length; ++i) {
+                        if (!same(actual.at(i).x(), expected.at(i).x()) || !same(actual.at(i).y(), expected.at(i).y())) {
+                            ++mismatches;
+                        }
+                    }
+                    ++cases;
+                }
+            }
+            const bool match = mismatches == 0;
+            allMatch = allMatch && match;
+
+            QJsonObject result;
+            result["verify"] = QStringLiteral("mapping");
+            result["isa"] = QLatin1String(LoadMappingKernel::isaName(isa));
+            result["cases"] = cases;
+            result["mismatches"] = mismatches;
+            result["match"] = match;
+            report(result);
+        }
+    }
+    return allMatch;
+}
+
+// 行为校验：每项输出一行 JSON（"check" 为名称，"pass" 为结果），由 --check 选择并注册为 CTest 用例
+
+// 回放确定性：同一归档由两个回放引擎逐帧步进驱动两个控件，每帧渲染结果逐像素一致；
+// 跳转到终点后的样本与连续步进到终点的样本一致
+bool checkReplayDeterminism() {
+    QTemporaryDir directory;
+    if (!directory.isValid()) return false;
+    const QString path = directory.filePath(QStringLiteral("replay.mlsa"));
+    const qint64 startMs = QDateTime::currentMSecsSinceEpoch() - 3600 * 1000;
+    {
+        LoadSessionWriter writer;
+        if (!writer.open(path)) return false;
+        QRandomGenerator random(17);
+        for (int i = 0; i < 12000; ++i) {
+            writer.append(startMs + qint64(i) * 10, 50.0 + 40.0 * std::sin(i * 0.003) + random.bounded(8.0));
+        }
+        writer.close();
+    }
+
+    auto sameSamples = [](const QVector<LoadTimelineWidget::Sample> &a, const QVector<LoadTimelineWidget::Sample> &b) {
+        if (a.size() != b.size()) return false;
+        for (qsizetype i = 0; i < a.size(); ++i) {
+            if (a.at(i).timestamp != b.at(i).timestamp || a.at(i).loadValue != b.at(i).loadValue) return false;
+        }
+        return true;
+    };
+
+    BenchWidget first(30);
+    BenchWidget second(30);
+    LoadReplayEngine firstEngine;
+    LoadReplayEngine secondEngine;
+    for (LoadReplayEngine *engine : {&firstEngine, &secondEngine}) {
+        if (!engine->open(path)) return false;
+        engine->setSpeed(20.0);
+    }
+    firstEngine.setTarget(&first.widget);
+    secondEngine.setTarget(&second.widget);
+
+    int frames = 0;
+    int imageMismatches = 0;
+    while (firstEngine.positionMs() < firstEngine.endMs() && frames < 10000) {
+        firstEngine.stepFrame();
+        secondEngine.stepFrame();
+        first.render();
+        second.render();
+        if (first.image != second.image) ++imageMismatches;
+        ++frames;
+    }
+    const bool positionsMatch = firstEngine.positionMs() == secondEngine.positionMs();
+    const bool samplesMatch = sameSamples(first.widget.samples(), second.widget.samples());
+
+    BenchWidget seeked(30);
+    LoadReplayEngine seekEngine;
+    if (!seekEngine.open(path)) return false;
+    seekEngine.setTarget(&seeked.widget);
+    seekEngine.seek(firstEngine.positionMs());
+    const bool seekMatches = sameSamples(seeked.widget.samples(), first.widget.samples());
+
+    const bool pass = frames > 0 && imageMismatches == 0 && positionsMatch && samplesMatch && seekMatches;
+    QJsonObject result;
+    result["check"] = QStringLiteral("replay_determinism");
+    result["frames"] = frames;
+    result["imageMismatches"] = imageMismatches;
+    result["samplesMatch"] = samplesMatch;
+    result["seekMatches"] = seekMatches;
+    result["pass"] = pass;
+    report(result);
+    return pass;
+}
+
+// 流式解析：输入按任意边界切块送入，未消费的尾部保留到下一块，结果与整块解析一致；
+// 注释、空行、分号/制表符分隔、CRLF 与附加列被接受，表头与残缺行计入拒绝数，末尾不完整的行/记录不被消费
+bool checkStreamParser() {
+    struct Expected {
+        qint64 timeMs;
+        double value;
+    };
+    const QByteArray csv = "# 会话导出\n"
+                           "time,load\n"
+                           "1000,10.5\n"
+                           "\n"
+                           "1010;20.25\r\n"
+                           "  1020\t30\n"
+                           "1030 40,附加列\n"
+                           "bad,line\n"
+                           "1040,\n"
+                           "1050,50.5\n"
+                           "1060,60";
+    const Expected csvExpected[] = {{1000, 10.5}, {1010, 20.25}, {1020, 30.0}, {1030, 40.0}, {1050, 50.5}};
+    const quint64 csvRejected = 3;
+    const QByteArray csvTail = "1060,60";
+
+    QVector<Expected> binaryExpected;
+    QByteArray binary;
+    QRandomGenerator random(19);
+    for (int i = 0; i < 64; ++i) {
+        const Expected sample{-5000 + qint64(i) * 250, random.bounded(200.0) - 50.0};
+        binaryExpected.append(sample);
+        char record[LoadBinaryParser::RecordBytes];
+        qToLittleEndian<qint64>(sample.timeMs, record);
+        quint64 valueBits;
+        std::memcpy(&valueBits, &sample.value, sizeof(valueBits));
+        qToLittleEndian<quint64>(valueBits, record + 8);
+        binary.append(record, sizeof(record));
+    }
+    const QByteArray binaryTail("\x01\x02\x03\x04\x05", 5);
+    binary += binaryTail;
+
+    int cases = 0;
+    int failures = 0;
+    for (const bool isCsv : {true, false}) {
+        const QByteArray &input = isCsv ? csv : binary;
+        for (const qsizetype chunk : {qsizetype(1), qsizetype(2), qsizetype(3), qsizetype(7), qsizetype(17),
+                                      qsizetype(64), input.size()}) {
+            LoadCsvParser csvParser;
+            LoadBinaryParser binaryParser;
+            QVector<Expected> parsed;
+            auto sink = [&parsed](qint64 timeMs, double value) { parsed.append({timeMs, value}); };
+            QByteArray pending;
+            for (qsizetype offset = 0; offset < input.size(); offset += chunk) {
+                pending += input.mid(offset, chunk);
+                const qsizetype consumed = isCsv ? csvParser.parse(pending.constData(), pending.size(), sink)
+                                                 : binaryParser.parse(pending.constData(), pending.size(), sink);
+                pending.remove(0, consumed);
+            }
+
+            bool match = pending == (isCsv ? csvTail : binaryTail);
+            if (isCsv) {
+                match = match && csvParser.rejectedLines() == csvRejected && parsed.size() == qsizetype(std::size(csvExpected));
+                for (qsizetype i = 0; match && i < parsed.size(); ++i) {
+                    match = parsed.at(i).timeMs == csvExpected[i].timeMs && parsed.at(i).value == csvExpected[i].value;
+                }
+            } else {
+                match = match && parsed.size() == binaryExpected.size();
+                for (qsizetype i = 0; match && i < parsed.size(); ++i) {
+                    match = parsed.at(i).timeMs == binaryExpected.at(i).timeMs
+                        && std::memcmp(&parsed.at(i).value, &binaryExpected.at(i).value, sizeof(double)) == 0;
+                }
+            }
+            ++cases;
+            if (!match) ++failures;
+        }
+    }
+
+    QJsonObject result;
+    result["check"] = QStringLiteral("stream_parser");
+    result["cases"] = cases;
+    result["failures"] = failures;
+    result["pass"] = failures == 0;
+    report(result);
+    return failures == 0;
+}
+
+// 信号调理：中值去除单个脉冲、EMA 阶跃响应符合时间常数、降采样输出周期均值与平均时刻、
+// 离群值与非有限值被剔除且计数守恒（输入 = 输出 + 剔除）
+bool checkSignalPipeline() {
+    QStringList failures;
+
+    {
+        LoadSignalPipeline median;
+        median.addMedian(5);
+        bool flat = true;
+        for (int i = 0; i < 40; ++i) {
+            qint64 timeMs = i * 10;
+            double value = i == 20 ? 1000.0 : 10.0;
+            flat = median.process(timeMs, value) && value == 10.0 && flat;
+        }
+        if (!flat) failures.append(QStringLiteral("median"));
+    }
+
+    {
+        // 10 ms 间隔、时间常数 100 ms：阶跃后第 10 个样本（累计 100 ms）处达到 1 - e^-1
+        LoadSignalPipeline ema;
+        ema.addEma(100.0);
+        double value = 0.0;
+        for (qint64 timeMs = -1000; timeMs <= 90; timeMs += 10) {
+            qint64 time = timeMs;
+            value = timeMs < 0 ? 0.0 : 100.0;
+            ema.process(time, value);
+        }
+        if (qAbs(value - 100.0 * (1.0 - std::exp(-1.0))) > 1e-9) failures.append(QStringLiteral("ema"));
+    }
+
+    {
+        // 100 ms 周期、10 ms 间隔、数值等于时刻：第 b 个周期输出 (b·100 + 45, b·100 + 45)，最后一个周期尚未结束
+        LoadSignalPipeline downsample;
+        downsample.addDownsample(100);
+        int outputs = 0;
+        bool exact = true;
+        for (qint64 timeMs = 0; timeMs < 1000; timeMs += 10) {
+            qint64 time = timeMs;
+            double value = double(timeMs);
+            if (downsample.process(time, value)) {
+                const qint64 expected = qint64(outputs) * 100 + 45;
+                exact = exact && time == expected && value == double(expected);
+                ++outputs;
+            }
+        }
+        if (!exact || outputs != 9) failures.append(QStringLiteral("downsample"));
+    }
+
+    {
+        LoadSignalPipeline outlier;
+        outlier.addOutlierRejection(4.0, 16);
+        int passedAfterSpike = 0;
+        bool spikeRejected = false;
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double inf = std::numeric_limits<double>::infinity();
+        for (int i = 0; i < 120; ++i) {
+            qint64 timeMs = i * 10;
+            double value = i % 2 == 0 ? 9.0 : 11.0;
+            if (i == 60) value = 100.0;
+            if (i == 70) value = nan;
+            if (i == 80) value = inf;
+            const bool passed = outlier.process(timeMs, value);
+            if (i == 60) spikeRejected = !passed;
+            if (i > 60 && passed) ++passedAfterSpike;
+        }
+        const bool counted = outlier.inputCount() == 120 && outlier.rejectedCount() == 3
+            && outlier.inputCount() == outlier.outputCount() + outlier.rejectedCount();
+        if (!spikeRejected || passedAfterSpike != 57 || !counted) failures.append(QStringLiteral("outlier"));
+    }
+
+    QJsonObject result;
+    result["check"] = QStringLiteral("signal_pipeline");
+    result["failures"] = failures.join(',');
+    result["pass"] = failures.isEmpty();
+    report(result);
+    return failures.isEmpty();
+}
+
+// 分层保留的驻留守恒：样本全部在时间窗口内时，原始层与汇总层的分区驻留之和与逐样本计算的结果完全一致；
+// 数据超出时间窗口后，与全部保留原始样本的模型相比每个分区的差异不超过最粗一层的桶间隔
+bool checkTierDwellConservation() {
+    constexpr int kWindowSeconds = 600;
+    constexpr qint64 kStepMs = 50;
+    constexpr qint64 kCoarseIntervalMs = 10000;
+    const auto clock = std::make_shared<LoadVirtualClock>(QDateTime::currentMSecsSinceEpoch());
+    LoadTimelineModel tiered;
+    LoadTimelineModel reference;
+    for (LoadTimelineModel *model : {&tiered, &reference}) {
+        model->setClock(clock);
+        model->setMinimumWindowSeconds(kWindowSeconds);
+    }
+    // 1 秒桶保留 2 分钟后下移到 10 秒桶，两层都被用到
+    tiered.setRetentionTiers({{1000, 120000}, {kCoarseIntervalMs, 0}});
+    tiered.setRawRetentionSeconds(60);
+
+    LoadZoneStatistics zones;
+    zones.setThresholds(tiered.mediumThreshold(), tiered.highThreshold());
+    LoadZoneStatistics::Dwell expected;
+    qint64 previousTime = 0;
+    double previousValue = 0.0;
+    bool hasPrevious = false;
+
+    QRandomGenerator random(23);
+    double value = 50.0;
+    QVector<qint64> times;
+    QVector<double> values;
+    bool exactInWindow = true;
+    qint64 maxDifferenceMs = 0;
+    // 每秒一批：前 500 秒全部在窗口内，其后样本开始离开窗口
+    for (int second = 0; second < 1500; ++second) {
+        times.resize(0);
+        values.resize(0);
+        for (qint64 offset = 0; offset < 1000; offset += kStepMs) {
+            value = qBound(0.0, value + random.bounded(12.0) - 6.0, 100.0);
+            times.append(clock->nowMs() + offset);
+            values.append(value);
+            if (hasPrevious) expected.zoneMs[zones.zoneFor(previousValue)] += clock->nowMs() + offset - previousTime;
+            previousTime = clock->nowMs() + offset;
+            previousValue = value;
+            hasPrevious = true;
+        }
+        clock->advance(1000);
+        tiered.appendSamples(LoadTimelineModel::PrimarySeriesId, times.constData(), values.constData(), times.size());
+        reference.appendSamples(LoadTimelineModel::PrimarySeriesId, times.constData(), values.constData(),
+                                times.size());
+
+        const LoadZoneStatistics::Dwell dwell = tiered.zoneDwell();
+        if (second < 500) {
+            for (int zone = 0; zone < LoadZoneStatistics::ZoneCount; ++zone) {
+                exactInWindow = exactInWindow && dwell.zoneMs[zone] == expected.zoneMs[zone];
+            }
+        } else {
+            const LoadZoneStatistics::Dwell referenceDwell = reference.zoneDwell();
+            for (int zone = 0; zone < LoadZoneStatistics::ZoneCount; ++zone) {
+                maxDifferenceMs = qMax(maxDifferenceMs, qAbs(dwell.zoneMs[zone] - referenceDwell.zoneMs[zone]));
+            }
+        }
+    }
+
+    const bool pass = exactInWindow && maxDifferenceMs <= kCoarseIntervalMs + kStepMs;
+    QJsonObject result;
+    result["check"] = QStringLiteral("tier_dwell_conservation");
+    result["exactInWindow"] = exactInWindow;
+    result["maxDifferenceMs"] = maxDifferenceMs;
+    result["pass"] = pass;
+    report(result);
+    return pass;
+}
+
+// 滑动窗口极值：随机追加（含 NaN 与 ±∞）与移出，每步与窗口内有限值的逐个比较结果一致
+bool checkWindowExtrema() {
+    LoadWindowExtrema extrema;
+    QVector<double> values;
+    qint64 first = 0;
+    QRandomGenerator random(29);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    int steps = 0;
+    int mismatches = 0;
+    for (int step = 0; step < 20000; ++step) {
+        const quint32 action = random.bounded(10);
+        if (action < 6) {
+            double value = random.bounded(1000.0) - 500.0;
+            if (action == 0 && random.bounded(8) == 0) value = random.bounded(2) == 0 ? nan : -inf;
+            if (action == 1 && random.bounded(8) == 0) value = inf;
+            // 偶尔追加重复值，覆盖并列极值
+            if (action == 2 && !values.isEmpty()) value = values.last();
+            extrema.append(first + values.size(), value);
+            values.append(value);
+        } else if (!values.isEmpty()) {
+            const qint64 drop = random.bounded(qMin<qint64>(values.size(), 8) + 1);
+            values.remove(0, drop);
+            first += drop;
+            extrema.dropBefore(first);
+        }
+
+        bool any = false;
+        double minimum = 0.0;
+        double maximum = 0.0;
+        for (const double v : values) {
+            if (!qIsFinite(v)) continue;
+            minimum = any ? qMin(minimum, v) : v;
+            maximum = any ? qMax(maximum, v) : v;
+            any = true;
+        }
+        const bool match = any ? !extrema.isEmpty() && extrema.min() == minimum && extrema.max() == maximum
+                               : extrema.isEmpty();
+        if (!match) ++mismatches;
+        ++steps;
+    }
+
+    QJsonObject result;
+    result["check"] = QStringLiteral("window_extrema");
+    result["steps"] = steps;
+    result["mismatches"] = mismatches;
+    result["pass"] = mismatches == 0;
+    report(result);
+    return mismatches == 0;
+}
+
+// 标注区间索引：顺序与乱序插入、按编号删除与过期交替进行，每次查询结果与逐个比较一致且按开始时刻排列
+bool checkAnnotationIndex() {
+    LoadAnnotationIndex index;
+    std::vector<LoadAnnotationIndex::Annotation> live;
+    QRandomGenerator random(31);
+    qint64 cursorMs = 0;
+    qint64 expireBound = std::numeric_limits<qint64>::min();
+    int queries = 0;
+    int mismatches = 0;
+    QVector<const LoadAnnotationIndex::Annotation *> found;
+    for (int step = 0; step < 20000; ++step) {
+        const quint32 action = random.bounded(20);
+        if (action < 10) {
+            // 多数按时间先后追加，少数插入到更早的位置；点事件与区间各半
+            cursorMs += random.bounded(200);
+            const qint64 startMs = action < 8 ? cursorMs : cursorMs - random.bounded(20000);
+            const qint64 endMs = action % 2 == 0 ? startMs : startMs + random.bounded(5000);
+            LoadAnnotationIndex::Annotation annotation;
+            annotation.id = index.insert(startMs, endMs, QString(), QColor());
+            annotation.startMs = startMs;
+            annotation.endMs = endMs;
+            live.push_back(annotation);
+        } else if (action < 12) {
+            const quint64 id = live.empty() || random.bounded(4) == 0 ? quint64(random.bounded(1000000)) + 1000000
+                                                                       : live[random.bounded(int(live.size()))].id;
+            const auto it = std::find_if(live.begin(), live.end(),
+                                         [id](const LoadAnnotationIndex::Annotation &a) { return a.id == id; });
+            const bool existed = it != live.end();
+            if (existed) live.erase(it);
+            if (index.remove(id) != existed) ++mismatches;
+        } else if (action < 13) {
+            expireBound = qMax(expireBound, cursorMs - 10000 - qint64(random.bounded(5000)));
+            index.expireBefore(expireBound);
+            live.erase(std::remove_if(live.begin(), live.end(),
+                                      [expireBound](const LoadAnnotationIndex::Annotation &a) {
+                                          return a.endMs < expireBound;
+                                      }),
+                       live.end());
+        } else {
+            const qint64 fromMs = cursorMs - random.bounded(30000);
+            const qint64 toMs = fromMs + random.bounded(8000);
+            found.clear();
+            index.query(fromMs, toMs, found);
+
+            std::vector<quint64> expected;
+            for (const LoadAnnotationIndex::Annotation &a : live) {
+                if (a.startMs <= toMs && a.endMs >= fromMs) expected.push_back(a.id);
+            }
+            std::vector<quint64> actual;
+            bool ordered = true;
+            for (qsizetype i = 0; i < found.size(); ++i) {
+                actual.push_back(found.at(i)->id);
+                if (i > 0 && found.at(i)->startMs < found.at(i - 1)->startMs) ordered = false;
+            }
+            std::sort(expected.begin(), expected.end());
+            std::sort(actual.begin(), actual.end());
+            if (!ordered || actual != expected) ++mismatches;
+            ++queries;
+        }
+        if (index.size() != qsizetype(live.size())) ++mismatches;
+    }
+
+    QJsonObject result;
+    result["check"] = QStringLiteral("annotation_index");
+    result["queries"] = queries;
+    result["mismatches"] = mismatches;
+    result["pass"] = mismatches == 0;
+    report(result);
+    return mismatches == 0;
+}
+
+// 乱序输入：setSamples 收到打乱（含同一时刻的多个样本）的输入后，存储结果与按时间稳定排序的输入一致，
+// 分区驻留与逐样本计算一致
+bool checkSamplesOrder() {
+    const auto clock = std::make_shared<LoadVirtualClock>(QDateTime::currentMSecsSinceEpoch());
+    LoadTimelineModel model;
+    model.setClock(clock);
+    model.setMinimumWindowSeconds(60);
+
+    // 每个时刻两个样本；打乱后数值按输入位置递增（0~99 循环，覆盖三个分区），用于确认同一时刻的样本保持输入顺序
+    QVector<LoadTimelineModel::Sample> input;
+    for (int i = 0; i < 2000; ++i) {
+        const qint64 timeMs = clock->nowMs() - 50000 + qint64(i / 2) * 40;
+        input.append({QDateTime::fromMSecsSinceEpoch(timeMs, QTimeZone::UTC), 0.0});
+    }
+    QRandomGenerator random(37);
+    std::shuffle(input.begin(), input.end(), std::mt19937(random.generate()));
+    for (qsizetype i = 0; i < input.size(); ++i) input[i].loadValue = double(i % 100);
+    QVector<LoadTimelineModel::Sample> expected = input;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const LoadTimelineModel::Sample &a, const LoadTimelineModel::Sample &b) {
+                         return a.timestamp < b.timestamp;
+                     });
+
+    model.setSamples(LoadTimelineModel::PrimarySeriesId, input);
+    const QVector<LoadTimelineModel::Sample> stored = model.samples(LoadTimelineModel::PrimarySeriesId);
+    bool ordered = stored.size() == expected.size();
+    for (qsizetype i = 0; ordered && i < stored.size(); ++i) {
+        ordered = stored.at(i).timestamp == expected.at(i).timestamp && stored.at(i).loadValue == expected.at(i).loadValue;
+    }
+
+    LoadZoneStatistics zones;
+    zones.setThresholds(model.mediumThreshold(), model.highThreshold());
+    LoadZoneStatistics::Dwell dwell;
+    for (qsizetype i = 0; i + 1 < expected.size(); ++i) {
+        dwell.zoneMs[zones.zoneFor(expected.at(i).loadValue)] +=
+            expected.at(i + 1).timestamp.toMSecsSinceEpoch() - expected.at(i).timestamp.toMSecsSinceEpoch();
+    }
+    bool dwellMatches = true;
+    for (int zone = 0; zone < LoadZoneStatistics::ZoneCount; ++zone) {
+        dwellMatches = dwellMatches && model.zoneDwell().zoneMs[zone] == dwell.zoneMs[zone];
+    }
+
+    const bool pass = ordered && dwellMatches;
+    QJsonObject result;
+    result["check"] = QStringLiteral("samples_order");
+    result["ordered"] = ordered;
+    result["dwellMatches"] = dwellMatches;
+    result["pass"] = pass;
+    report(result);
+    return pass;
+}
+
+struct Check {
+    const char *name;
+    bool (*run)();
+};
+
+const Check kChecks[] = {
+    {"replay_determinism", checkReplayDeterminism},
+    {"stream_parser", checkStreamParser},
+    {"signal_pipeline", checkSignalPipeline},
+    {"tier_dwell_conservation", checkTierDwellConservation},
+    {"window_extrema", checkWindowExtrema},
+    {"annotation_index", checkAnnotationIndex},
+    {"samples_order", checkSamplesOrder},
+};
+
+// 运行名称为 name 的校验（all 为全部），返回进程退出码：全部通过为 0，失败或名称未知为 1
+int runChecks(const QString &name) {
+    bool known = false;
+    bool pass = true;
+    for (const Check &check : kChecks) {
+        if (name != QLatin1String("all") && name != QLatin1String(check.name)) continue;
+        known = true;
+        pass = check.run() && pass;
+    }
+    if (!known) {
+        QTextStream(stderr) << "unknown check: " << name << '\n';
+        return 1;
+    }
+    return pass ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    // 默认使用 offscreen 平台，无需显示器即可运行
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // DPR 只能在创建 QApplication 之前通过 QT_SCALE_FACTOR 设定：
+    // 父进程按 --dprs 逐个以子进程方式运行渲染基准
+    const QByteArray childDpr = qgetenv("MENTAL_LOAD_BENCH_DPR");
+    if (!childDpr.isEmpty()) {
+        qputenv("QT_SCALE_FACTOR", childDpr);
+    }
+
+    QApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("LoadTimelineWidget headless benchmark (JSON lines on stdout)"));
+    parser.addHelpOption();
+    QCommandLineOption samplesOption(QStringLiteral("samples"), QStringLiteral("Comma-separated sample counts."),
+                                     QStringLiteral("list"), QStringLiteral("1000,15000,150000"));
+    QCommandLineOption windowsOption(QStringLiteral("windows"), QStringLiteral("Comma-separated window lengths (s)."),
+                                     QStringLiteral("list"), QStringLiteral("60,600"));
+    QCommandLineOption dprsOption(QStringLiteral("dprs"), QStringLiteral("Comma-separated device pixel ratios."),
+                                  QStringLiteral("list"), QStringLiteral("1,2"));
+    QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Minimum frames per render case."),
+                                    QStringLiteral("count"), QStringLiteral("20"));
+    QCommandLineOption skipRenderOption(QStringLiteral("skip-render"), QStringLiteral("Skip render benchmarks."));
+    QCommandLineOption skipIngestOption(QStringLiteral("skip-ingest"), QStringLiteral("Skip ingest benchmarks."));
+    QCommandLineOption verifyOption(QStringLiteral("verify"),
+                                    QStringLiteral("Check SIMD mapping kernels against the scalar kernel and exit."));
+    QCommandLineOption checkOption(QStringLiteral("check"),
+                                   QStringLiteral("Run a behavior check (replay_determinism, stream_parser, "
+                                                  "signal_pipeline, tier_dwell_conservation, window_extrema, "
+                                                  "annotation_index, samples_order or all) and exit."),
+                                   QStringLiteral("name"));
+    parser.addOptions({samplesOption, windowsOption, dprsOption, framesOption, skipRenderOption, skipIngestOption,
+                       verifyOption, checkOption});
+    parser.process(app);
+
+    const QList<int> sampleCounts = parseIntList(parser.value(samplesOption));
+    const QList<int> windows = parseIntList(parser.value(windowsOption));
+    const int minFrames = qMax(1, parser.value(framesOption).toInt());
+
+    if (parser.isSet(verifyOption)) {
+        return verifyMapping() ? 0 : 1;
+    }
+    if (parser.isSet(checkOption)) {
+        return runChecks(parser.value(checkOption));
+    }
+
+    if (!childDpr.isEmpty()) {
+        benchRender(sampleCounts, windows, minFrames, app.devicePixelRatio());
+        benchDashboard(minFrames * 5);
+        return 0;
+    }
+
+    if (!parser.isSet(skipRenderOption)) {
+        for (const QString &dpr : parser.value(dprsOption).split(',', Qt::SkipEmptyParts)) {
+            QProcess child;
+            QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+            env.insert(QStringLiteral("MENTAL_LOAD_BENCH_DPR"), dpr.trimmed());
+            child.setProcessEnvironment(env);
+            child.setProcessChannelMode(QProcess::ForwardedChannels);
+            child.start(QCoreApplication::applicationFilePath(),
+                        {QStringLiteral("--samples"), parser.value(samplesOption),
+                         QStringLiteral("--windows"), parser.value(windowsOption),
+                         QStringLiteral("--frames"), QString::number(minFrames)});
+            child.waitForFinished(-1);
+        }
+    }
+
+    if (!parser.isSet(skipIngestOption)) {
+        benchIngest(sampleCounts, windows);
+        benchMapping(sampleCounts, windows);
+        benchPipeline(sampleCounts);
+        benchRetention(minFrames);
+        benchHover(minFrames);
+        benchAnnotations(minFrames);
+        benchSharedModel(minFrames);
+        benchParse(sampleCounts);
+    }
+    return 0;
+}
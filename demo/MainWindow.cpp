@@ -4,8 +4,11 @@
 #include <QDateTime>
 #include <QDoubleSpinBox>
 #include <QFormLayout>
+#include <QKeySequence>
 #include <QRandomGenerator>
+#include <QShortcut>
 #include <QSpinBox>
+#include <QTimeZone>
 #include <QVBoxLayout>
 
 MainWindow::MainWindow(QWidget *parent)
@@ -17,6 +20,13 @@ MainWindow::MainWindow(QWidget *parent)
     m_widget = new LoadTimelineWidget(this);
     layout->addWidget(m_widget);
 
+    // 细节视图：共用主控件的数据模型，只显示最近 15 秒，样本不重复存储
+    m_detailWidget = new LoadTimelineWidget(this);
+    m_detailWidget->setModel(m_widget->model());
+    m_detailWidget->setTimeWindowSeconds(15);
+    m_detailWidget->setMaximumHeight(140);
+    layout->addWidget(m_detailWidget);
+
     // 配置区
     QFormLayout *form = new QFormLayout();
 
@@ -66,24 +76,93 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_smoothCheck, &QCheckBox::toggled, m_widget, &LoadTimelineWidget::setSmoothingEnabled);
     form->addRow(m_smoothCheck);
 
+    // 接入信号调理：剔除离群值后取 5 点滑动中值，再做 250 ms 指数平滑
+    m_conditionCheck = new QCheckBox("信号调理（离群值剔除 + 中值 + EMA）", this);
+    connect(m_conditionCheck, &QCheckBox::toggled, this, [this](bool enabled) {
+        LoadSignalPipeline pipeline;
+        if (enabled) {
+            pipeline.addOutlierRejection(4.0);
+            pipeline.addMedian(5);
+            pipeline.addEma(250.0);
+        }
+        m_widget->setIngestPipeline(LoadTimelineWidget::PrimarySeriesId, pipeline);
+    });
+    form->addRow(m_conditionCheck);
+
+    // 自动量程启用时负荷上下限只作为无数据时的默认范围
+    m_autoScaleCheck = new QCheckBox("自动量程", this);
+    m_autoScaleCheck->setChecked(m_widget->autoScaleEnabled());
+    connect(m_autoScaleCheck, &QCheckBox::toggled, m_widget, &LoadTimelineWidget::setAutoScaleEnabled);
+    connect(m_autoScaleCheck, &QCheckBox::toggled, m_loadMinSpin, &QWidget::setDisabled);
+    connect(m_autoScaleCheck, &QCheckBox::toggled, m_loadMaxSpin, &QWidget::setDisabled);
+    form->addRow(m_autoScaleCheck);
+
     layout->addLayout(form);
     setCentralWidget(central);
-    resize(720, 420);
+    resize(720, 560);
 
     // 定时生成样例数据
     connect(&m_timer, &QTimer::timeout, this, &MainWindow::handleAddSample);
     m_timer.start(1000);
 }
 
+bool MainWindow::startReplay(const QString &path, double speed) {
+    if (!m_replay) {
+        m_replay = new LoadReplayEngine(this);
+        connect(new QShortcut(QKeySequence(Qt::Key_Space), this), &QShortcut::activated, m_replay, [this]() {
+            if (m_replay->isPlaying()) {
+                m_replay->pause();
+            } else {
+                m_replay->play();
+            }
+        });
+        connect(new QShortcut(QKeySequence(Qt::Key_Right), this), &QShortcut::activated, m_replay,
+                &LoadReplayEngine::stepFrame);
+    }
+    if (!m_replay->open(path)) return false;
+
+    m_timer.stop();
+    m_replay->setTarget(m_widget);
+    m_replay->setSpeed(speed);
+    m_replay->play();
+    return true;
+}
+
+bool MainWindow::startStream(const QString &name, bool localSocket, LoadStreamSource::Format format) {
+    if (!m_stream) {
+        m_stream = new LoadStreamSource(this);
+        m_stream->setTarget(m_widget);
+        connect(m_stream, &LoadStreamSource::errorOccurred, this,
+                [](const QString &message) { qWarning("数据源错误: %s", qPrintable(message)); });
+    }
+    const bool started = localSocket ? m_stream->connectToServer(name, format) : m_stream->openFile(name, format);
+    if (started) {
+        m_timer.stop();
+    }
+    return started;
+}
+
 void MainWindow::handleAddSample() {
     // 生成假数据：基于随机数模拟高/中/低波动
     double base = QRandomGenerator::global()->bounded(m_widget->loadMin(), m_widget->loadMax());
     double jitter = QRandomGenerator::global()->bounded(-5.0, 5.0);
 
     LoadTimelineWidget::Sample sample;
-    sample.timestamp = QDateTime::currentDateTimeUtc();
+    // 与控件共用时间源，样本时刻与绘制时刻一致
+    sample.timestamp = QDateTime::fromMSecsSinceEpoch(m_widget->clock()->nowMs(), QTimeZone::UTC);
     sample.loadValue = base + jitter;
 
     m_widget->appendSample(sample);
+
+    // 标注示例：每 15 个样本开始一个新阶段（区间），高负荷样本标记为告警（点事件）
+    if (m_sampleCount % 15 == 0) {
+        m_widget->addAnnotation(sample.timestamp, sample.timestamp.addSecs(15),
+                                QStringLiteral("阶段 %1").arg(m_sampleCount / 15 + 1),
+                                m_sampleCount / 15 % 2 == 0 ? QColor(0, 137, 123) : QColor(94, 53, 177));
+    }
+    if (sample.loadValue >= m_widget->highThreshold()) {
+        m_widget->addAnnotation(sample.timestamp, QStringLiteral("告警"), QColor(198, 40, 40));
+    }
+    ++m_sampleCount;
 }
 
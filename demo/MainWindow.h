@@ -2,6 +2,8 @@
 
 #include <QMainWindow>
 #include <QTimer>
+#include "../src/widget/LoadReplayEngine.h"
+#include "../src/widget/LoadStreamSource.h"
 #include "../src/widget/LoadTimelineWidget.h"
 
 class QSpinBox;
@@ -14,12 +16,20 @@ class MainWindow : public QMainWindow {
 public:
     explicit MainWindow(QWidget *parent = nullptr);
 
+    // 以回放归档代替随机样例数据
+    bool startReplay(const QString &path, double speed);
+    // 以流式数据源（文件/管道或本地套接字）代替随机样例数据
+    bool startStream(const QString &name, bool localSocket, LoadStreamSource::Format format);
+
 private slots:
     void handleAddSample();
 
 private:
     LoadTimelineWidget *m_widget = nullptr;
+    LoadTimelineWidget *m_detailWidget = nullptr;
     QTimer m_timer;
+    LoadReplayEngine *m_replay = nullptr;
+    LoadStreamSource *m_stream = nullptr;
     QSpinBox *m_timeWindowSpin = nullptr;
     QSpinBox *m_tickIntervalSpin = nullptr;
     QDoubleSpinBox *m_highSpin = nullptr;
@@ -28,5 +38,9 @@ private:
     QDoubleSpinBox *m_loadMinSpin = nullptr;
     QCheckBox *m_gridCheck = nullptr;
     QCheckBox *m_smoothCheck = nullptr;
+    QCheckBox *m_conditionCheck = nullptr;
+    QCheckBox *m_autoScaleCheck = nullptr;
+    // 随机数据已生成的样本数（用于示例标注）
+    int m_sampleCount = 0;
 };
 
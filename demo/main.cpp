@@ -1,10 +1,49 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include "MainWindow.h"
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("心理负荷时间轴控件示例"));
+    parser.addHelpOption();
+    const QCommandLineOption replayOption(QStringLiteral("replay"),
+                                          QStringLiteral("回放会话归档（空格暂停/继续，右方向键逐帧）"),
+                                          QStringLiteral("archive"));
+    const QCommandLineOption speedOption(QStringLiteral("speed"), QStringLiteral("回放倍速（1~1000）"),
+                                         QStringLiteral("factor"), QStringLiteral("1"));
+    const QCommandLineOption sourceOption(QStringLiteral("source"),
+                                          QStringLiteral("从文件或管道读取样本（\"-\" 表示标准输入）"),
+                                          QStringLiteral("path"));
+    const QCommandLineOption socketOption(QStringLiteral("source-socket"),
+                                          QStringLiteral("从本地套接字（QLocalServer 名称）读取样本"),
+                                          QStringLiteral("name"));
+    const QCommandLineOption formatOption(QStringLiteral("format"),
+                                          QStringLiteral("数据源格式：csv（时间戳毫秒,负荷值）或 binary（int64 + double 小端记录）"),
+                                          QStringLiteral("csv|binary"), QStringLiteral("csv"));
+    parser.addOption(replayOption);
+    parser.addOption(speedOption);
+    parser.addOption(sourceOption);
+    parser.addOption(socketOption);
+    parser.addOption(formatOption);
+    parser.process(app);
+
     MainWindow window;
+    if (parser.isSet(replayOption) && !window.startReplay(parser.value(replayOption), parser.value(speedOption).toDouble())) {
+        qWarning("无法打开归档: %s", qPrintable(parser.value(replayOption)));
+        return 1;
+    }
+    const LoadStreamSource::Format format = parser.value(formatOption) == QLatin1String("binary")
+        ? LoadStreamSource::BinaryFormat
+        : LoadStreamSource::CsvFormat;
+    if (parser.isSet(sourceOption) && !window.startStream(parser.value(sourceOption), false, format)) {
+        qWarning("无法打开数据源: %s", qPrintable(parser.value(sourceOption)));
+        return 1;
+    }
+    if (parser.isSet(socketOption)) {
+        window.startStream(parser.value(socketOption), true, format);
+    }
     window.show();
     return app.exec();
 }
-
@@ -0,0 +1,135 @@
+#include "LoadAnnotationIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr qint64 kRetired = std::numeric_limits<qint64>::min();
+} // namespace
+
+bool LoadAnnotationIndex::isLive(const Annotation &annotation) {
+    return annotation.endMs != kRetired;
+}
+
+void LoadAnnotationIndex::retire(Annotation &annotation) {
+    annotation.endMs = kRetired;
+    annotation.label.clear();
+    --m_liveCount;
+}
+
+quint64 LoadAnnotationIndex::insert(qint64 startMs, qint64 endMs, const QString &label, const QColor &color) {
+    if (endMs < startMs) std::swap(startMs, endMs);
+    Annotation annotation;
+    annotation.id = m_nextId++;
+    annotation.startMs = startMs;
+    annotation.endMs = endMs;
+    annotation.label = label;
+    annotation.color = color;
+    ++m_liveCount;
+
+    // 开始时刻不早于末尾条目时直接追加（常见情形），否则插入到排序位置
+    if (m_entries.size() == size_t(m_head) || m_entries.back().startMs <= startMs) {
+        m_entries.push_back(std::move(annotation));
+        const qsizetype index = qsizetype(m_entries.size()) - 1;
+        if (!m_treeDirty && index < m_leafCount) {
+            updateLeaf(index);
+        } else {
+            m_treeDirty = true;
+        }
+    } else {
+        const auto position = std::upper_bound(m_entries.begin() + m_head, m_entries.end(), startMs,
+                                               [](qint64 time, const Annotation &entry) { return time < entry.startMs; });
+        m_entries.insert(position, std::move(annotation));
+        m_treeDirty = true;
+    }
+    return m_nextId - 1;
+}
+
+bool LoadAnnotationIndex::remove(quint64 id) {
+    for (size_t i = size_t(m_head); i < m_entries.size(); ++i) {
+        Annotation &annotation = m_entries[i];
+        if (annotation.id != id || !isLive(annotation)) continue;
+        retire(annotation);
+        if (!m_treeDirty) updateLeaf(qsizetype(i));
+        return true;
+    }
+    return false;
+}
+
+void LoadAnnotationIndex::clear() {
+    m_entries.clear();
+    m_head = 0;
+    m_liveCount = 0;
+    m_tree.clear();
+    m_leafCount = 0;
+    m_treeDirty = false;
+}
+
+void LoadAnnotationIndex::expireBefore(qint64 boundMs) {
+    // 结束时刻早于界限的条目开始时刻也早于界限，只需检查开始时刻早于界限的前缀
+    const qsizetype count = qsizetype(m_entries.size());
+    for (qsizetype i = m_head; i < count && m_entries[size_t(i)].startMs < boundMs; ++i) {
+        Annotation &annotation = m_entries[size_t(i)];
+        if (!isLive(annotation) || annotation.endMs >= boundMs) continue;
+        retire(annotation);
+        if (!m_treeDirty) updateLeaf(i);
+    }
+    while (m_head < count && !isLive(m_entries[size_t(m_head)])) {
+        ++m_head;
+    }
+
+    // 释放的前缀超过一半时整理存储，整理开销由此前的追加均摊
+    if (m_head > 0 && m_head * 2 >= count) {
+        m_entries.erase(m_entries.begin(), m_entries.begin() + m_head);
+        m_head = 0;
+        m_treeDirty = true;
+    }
+}
+
+void LoadAnnotationIndex::query(qint64 fromMs, qint64 toMs, QVector<const Annotation *> &out) const {
+    if (m_liveCount == 0 || toMs < fromMs) return;
+    if (m_treeDirty) rebuildTree();
+
+    // 开始时刻不晚于 toMs 的前缀 [m_head, to)，其中结束时刻不早于 fromMs 的条目即为相交条目
+    const auto last = std::upper_bound(m_entries.begin() + m_head, m_entries.end(), toMs,
+                                       [](qint64 time, const Annotation &entry) { return time < entry.startMs; });
+    const qsizetype to = qsizetype(last - m_entries.begin());
+    if (to <= m_head) return;
+    collect(1, 0, m_leafCount, to, fromMs, out);
+}
+
+void LoadAnnotationIndex::collect(qsizetype node, qsizetype nodeFrom, qsizetype nodeTo, qsizetype to,
+                                  qint64 fromMs, QVector<const Annotation *> &out) const {
+    // 已释放前缀的叶子值为最小值，不会被下探
+    if (nodeFrom >= to || m_tree[size_t(node)] < fromMs) return;
+    if (nodeTo - nodeFrom == 1) {
+        out.append(&m_entries[size_t(nodeFrom)]);
+        return;
+    }
+    const qsizetype middle = nodeFrom + (nodeTo - nodeFrom) / 2;
+    collect(node * 2, nodeFrom, middle, to, fromMs, out);
+    collect(node * 2 + 1, middle, nodeTo, to, fromMs, out);
+}
+
+void LoadAnnotationIndex::updateLeaf(qsizetype index) const {
+    qsizetype node = m_leafCount + index;
+    m_tree[size_t(node)] = index >= m_head ? m_entries[size_t(index)].endMs : kRetired;
+    for (node /= 2; node >= 1; node /= 2) {
+        m_tree[size_t(node)] = qMax(m_tree[size_t(node) * 2], m_tree[size_t(node) * 2 + 1]);
+    }
+}
+
+void LoadAnnotationIndex::rebuildTree() const {
+    // 叶子数取 2 的幂并预留一倍余量，按时间先后追加时在余量用完前只做路径更新
+    qsizetype leaves = 1;
+    while (leaves < qsizetype(m_entries.size()) * 2) leaves *= 2;
+    m_leafCount = leaves;
+    m_tree.assign(size_t(leaves) * 2, kRetired);
+    for (size_t i = size_t(m_head); i < m_entries.size(); ++i) {
+        m_tree[size_t(leaves) + i] = m_entries[i].endMs;
+    }
+    for (qsizetype node = leaves - 1; node >= 1; --node) {
+        m_tree[size_t(node)] = qMax(m_tree[size_t(node) * 2], m_tree[size_t(node) * 2 + 1]);
+    }
+    m_treeDirty = false;
+}
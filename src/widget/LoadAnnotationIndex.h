@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QColor>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include <vector>
+
+// 标注区间索引：标注按开始时刻排序存放，其上叠加一棵记录子树最大结束时刻的线段树。
+// 查询与 [fromMs, toMs] 相交的标注时，先二分出开始时刻不晚于 toMs 的前缀，再只下探最大结束时刻
+// 不早于 fromMs 的子树，开销为 O(log n + k)。按时间先后追加时只更新一条叶到根的路径；
+// 乱序插入或整理存储后线段树在下次查询时整体重建。过期只移出开始时刻最早的连续前缀，
+// 被更早开始的长区间挡住的过期条目先标记为失效（不再命中），随前缀一起释放。
+class LoadAnnotationIndex {
+public:
+    struct Annotation {
+        quint64 id = 0;
+        qint64 startMs = 0;
+        // 点事件的结束时刻等于开始时刻
+        qint64 endMs = 0;
+        QString label;
+        QColor color;
+
+        bool isPoint() const { return endMs == startMs; }
+    };
+
+    // 插入标注，返回编号（从 1 开始递增）；endMs 早于 startMs 时两者交换
+    quint64 insert(qint64 startMs, qint64 endMs, const QString &label, const QColor &color);
+    // 按编号删除（线性查找），不存在时返回 false
+    bool remove(quint64 id);
+    void clear();
+    // 结束时刻早于 boundMs 的标注失效，并释放开始时刻最早的连续失效前缀
+    void expireBefore(qint64 boundMs);
+
+    // 有效标注数
+    qsizetype size() const { return m_liveCount; }
+    bool isEmpty() const { return m_liveCount == 0; }
+
+    // 与 [fromMs, toMs] 相交的有效标注按开始时刻先后追加到 out；指针在下次修改索引前有效
+    void query(qint64 fromMs, qint64 toMs, QVector<const Annotation *> &out) const;
+
+private:
+    static bool isLive(const Annotation &annotation);
+    void retire(Annotation &annotation);
+    void updateLeaf(qsizetype index) const;
+    void rebuildTree() const;
+    void collect(qsizetype node, qsizetype nodeFrom, qsizetype nodeTo, qsizetype to, qint64 fromMs,
+                 QVector<const Annotation *> &out) const;
+
+    std::vector<Annotation> m_entries;
+    // 自 m_head 起为仍占用存储的条目（含失效条目）
+    qsizetype m_head = 0;
+    qsizetype m_liveCount = 0;
+    quint64 m_nextId = 1;
+    // 线段树：叶子对应 m_entries 下标，值为结束时刻（失效条目为最小值），内部节点取子节点最大值
+    mutable std::vector<qint64> m_tree;
+    mutable qsizetype m_leafCount = 0;
+    mutable bool m_treeDirty = false;
+};
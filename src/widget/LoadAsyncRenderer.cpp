@@ -0,0 +1,122 @@
+#include "LoadAsyncRenderer.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <utility>
+
+struct LoadAsyncRenderer::State {
+    mutable QMutex mutex;
+    QWaitCondition idle;
+    std::function<void()> frameReady;
+    bool busy = false;
+    bool hasPending = false;
+    Snapshot pending;
+    // 前缓冲供 GUI 线程读取；后缓冲只由在途任务写入
+    Frame front;
+    QImage back;
+    quint64 dropped = 0;
+};
+
+LoadAsyncRenderer::LoadAsyncRenderer(std::function<void()> frameReady)
+    : m_state(std::make_shared<State>()) {
+    m_state->frameReady = std::move(frameReady);
+}
+
+LoadAsyncRenderer::~LoadAsyncRenderer() {
+    QMutexLocker locker(&m_state->mutex);
+    m_state->hasPending = false;
+    while (m_state->busy) {
+        m_state->idle.wait(&m_state->mutex);
+    }
+    m_state->frameReady = nullptr;
+}
+
+QThreadPool *LoadAsyncRenderer::sharedPool() {
+    static QThreadPool *pool = [] {
+        auto *threadPool = new QThreadPool;
+        threadPool->setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+        return threadPool;
+    }();
+    return pool;
+}
+
+void LoadAsyncRenderer::submit(Snapshot snapshot) {
+    // 阶段统计不跨线程累加
+    snapshot.renderer.setStats(nullptr);
+    {
+        QMutexLocker locker(&m_state->mutex);
+        if (m_state->busy) {
+            // 工作线程落后：只保留最新快照
+            if (m_state->hasPending) ++m_state->dropped;
+            m_state->pending = std::move(snapshot);
+            m_state->hasPending = true;
+            return;
+        }
+        m_state->busy = true;
+    }
+    std::shared_ptr<State> state = m_state;
+    sharedPool()->start([state, snapshot = std::move(snapshot)]() mutable { run(state, std::move(snapshot)); });
+}
+
+LoadAsyncRenderer::Frame LoadAsyncRenderer::latestFrame() const {
+    QMutexLocker locker(&m_state->mutex);
+    return m_state->front;
+}
+
+quint64 LoadAsyncRenderer::droppedFrames() const {
+    QMutexLocker locker(&m_state->mutex);
+    return m_state->dropped;
+}
+
+void LoadAsyncRenderer::run(const std::shared_ptr<State> &state, Snapshot snapshot) {
+    for (;;) {
+        // 后缓冲只在此处访问，无需加锁
+        rasterize(snapshot, state->back);
+
+        QMutexLocker locker(&state->mutex);
+        std::swap(state->front.image, state->back);
+        state->front.nowMs = snapshot.nowMs;
+        if (state->frameReady) state->frameReady();
+        if (!state->hasPending) {
+            state->busy = false;
+            state->idle.wakeAll();
+            return;
+        }
+        snapshot = std::move(state->pending);
+        state->pending = Snapshot();
+        state->hasPending = false;
+    }
+}
+
+void LoadAsyncRenderer::rasterize(const Snapshot &snapshot, QImage &image) {
+    if (image.size() != snapshot.pixelSize) {
+        image = QImage(snapshot.pixelSize, QImage::Format_ARGB32_Premultiplied);
+    }
+    image.setDevicePixelRatio(snapshot.devicePixelRatio);
+    image.fill(Qt::transparent);
+    if (image.isNull()) return;
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.save();
+    // 与同步绘制一致：纵向留出线宽，避免裁掉贴边的描边
+    const qreal penWidth = 2.0 * snapshot.scale;
+    painter.setClipRect(snapshot.area.adjusted(0, -penWidth, 0, penWidth));
+    for (const CurveSnapshot &curve : snapshot.curves) {
+        if (curve.points.size() < 2) continue;
+        if (snapshot.zoneColoring) {
+            snapshot.renderer.drawZoneCurve(painter, curve.points, snapshot.area, snapshot.scale);
+        } else {
+            snapshot.renderer.drawCurve(painter, snapshot.renderer.buildPath(curve.points), curve.color, snapshot.scale);
+        }
+    }
+    painter.restore();
+    if (snapshot.labelVisible) {
+        snapshot.renderer.drawCurrentValueLabel(painter, snapshot.labelPoint, snapshot.labelValue, snapshot.scale);
+    }
+}
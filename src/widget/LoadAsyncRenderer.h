@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QVector>
+#include <QtGlobal>
+
+#include <functional>
+#include <memory>
+
+#include "LoadTimelineRenderer.h"
+
+class QThreadPool;
+
+// 异步曲线栅格化：工作线程按数据快照把曲线与当前值标签绘制到透明 QImage，GUI 线程只贴最新完成的帧。
+// 每个实例同一时刻最多一个任务在途；任务未完成时新快照替换待处理快照（丢帧），
+// 前后两张图像交替使用（双缓冲）。所有实例共用进程内的一个工作线程池。
+class LoadAsyncRenderer {
+public:
+    struct CurveSnapshot {
+        QVector<QPointF> points;
+        QColor color;
+    };
+
+    // 绘制所需的全部输入，构造后与控件状态无关，可跨线程传递
+    struct Snapshot {
+        LoadTimelineRenderer renderer;
+        QSize pixelSize;
+        qreal devicePixelRatio = 1.0;
+        qreal scale = 1.0;
+        QRectF area;
+        qint64 nowMs = 0;
+        // 分区着色：在阈值穿越处切分，以分区颜色描边，忽略曲线颜色
+        bool zoneColoring = false;
+        QVector<CurveSnapshot> curves;
+        bool labelVisible = false;
+        QPointF labelPoint;
+        double labelValue = 0.0;
+    };
+
+    // 已完成的帧及其快照时刻，贴图时按经过的时间平移
+    struct Frame {
+        QImage image;
+        qint64 nowMs = 0;
+    };
+
+    // frameReady 在工作线程中调用，应只投递通知（如排队调用 update()）
+    explicit LoadAsyncRenderer(std::function<void()> frameReady);
+    // 等待在途任务结束，之后不再调用 frameReady
+    ~LoadAsyncRenderer();
+
+    LoadAsyncRenderer(const LoadAsyncRenderer &) = delete;
+    LoadAsyncRenderer &operator=(const LoadAsyncRenderer &) = delete;
+
+    void submit(Snapshot snapshot);
+    Frame latestFrame() const;
+    // 被新快照替换而未绘制的快照数
+    quint64 droppedFrames() const;
+
+    // 进程内共享线程池：保留一个核心给 GUI 线程
+    static QThreadPool *sharedPool();
+
+private:
+    struct State;
+    static void run(const std::shared_ptr<State> &state, Snapshot snapshot);
+    static void rasterize(const Snapshot &snapshot, QImage &image);
+
+    std::shared_ptr<State> m_state;
+};
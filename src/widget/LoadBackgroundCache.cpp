@@ -0,0 +1,37 @@
+#include "LoadBackgroundCache.h"
+
+#include <QHash>
+
+namespace {
+QHash<QByteArray, std::weak_ptr<const QPixmap>> &entries() {
+    static QHash<QByteArray, std::weak_ptr<const QPixmap>> table;
+    return table;
+}
+
+void purgeExpired() {
+    auto &table = entries();
+    for (auto it = table.begin(); it != table.end();) {
+        it = it->expired() ? table.erase(it) : std::next(it);
+    }
+}
+} // namespace
+
+std::shared_ptr<const QPixmap> LoadBackgroundCache::acquire(const QByteArray &key,
+                                                            const std::function<QPixmap()> &render) {
+    auto &table = entries();
+    const auto found = table.constFind(key);
+    if (found != table.constEnd()) {
+        if (std::shared_ptr<const QPixmap> pixmap = found->lock()) return pixmap;
+    }
+
+    auto pixmap = std::make_shared<const QPixmap>(render());
+    // 条目数与同时存在的不同外观数同量级，插入时顺带清理即可
+    purgeExpired();
+    table.insert(key, pixmap);
+    return pixmap;
+}
+
+qsizetype LoadBackgroundCache::entryCount() {
+    purgeExpired();
+    return entries().size();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QByteArray>
+#include <QPixmap>
+#include <QtGlobal>
+
+#include <functional>
+#include <memory>
+
+// 进程共享的背景缓存：尺寸、设备像素比、字体与背景相关属性完全相同的控件共用同一张背景贴图。
+// 缓存只持有弱引用，最后一个使用者释放后条目随之失效。仅在 GUI 线程中使用。
+class LoadBackgroundCache {
+public:
+    // 按键查找背景；未命中时调用 render 生成并登记
+    static std::shared_ptr<const QPixmap> acquire(const QByteArray &key, const std::function<QPixmap()> &render);
+
+    // 当前仍被使用的背景数
+    static qsizetype entryCount();
+};
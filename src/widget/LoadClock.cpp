@@ -0,0 +1,13 @@
+#include "LoadClock.h"
+
+#include <QDateTime>
+
+std::shared_ptr<LoadClock> LoadClock::systemClock() {
+    static const std::shared_ptr<LoadClock> clock = std::make_shared<LoadMonotonicClock>();
+    return clock;
+}
+
+LoadMonotonicClock::LoadMonotonicClock()
+    : m_epochMs(QDateTime::currentMSecsSinceEpoch()) {
+    m_elapsed.start();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+#include <atomic>
+#include <memory>
+
+// 时间源：控件每帧读取一次“当前时刻”（UTC 毫秒），裁剪、映射与贴图共用该时刻。
+// 实现须可在任意线程读取。
+class LoadClock {
+public:
+    virtual ~LoadClock() = default;
+    virtual qint64 nowMs() const = 0;
+
+    // 进程共享的实时时钟（LoadMonotonicClock），控件默认使用
+    static std::shared_ptr<LoadClock> systemClock();
+};
+
+// 实时时钟：构造时锚定系统时间，此后按单调时钟推进，不受系统校时回拨影响
+class LoadMonotonicClock : public LoadClock {
+public:
+    LoadMonotonicClock();
+    qint64 nowMs() const override { return m_epochMs + m_elapsed.elapsed(); }
+
+private:
+    qint64 m_epochMs = 0;
+    QElapsedTimer m_elapsed;
+};
+
+// 虚拟时钟：时刻只由调用方设置或推进，用于回放与可复现的基准测试
+class LoadVirtualClock : public LoadClock {
+public:
+    explicit LoadVirtualClock(qint64 startMs = 0) : m_nowMs(startMs) {}
+    qint64 nowMs() const override { return m_nowMs.load(std::memory_order_relaxed); }
+
+    void setNowMs(qint64 timeMs) { m_nowMs.store(timeMs, std::memory_order_relaxed); }
+    void advance(qint64 deltaMs) { m_nowMs.fetch_add(deltaMs, std::memory_order_relaxed); }
+
+private:
+    std::atomic<qint64> m_nowMs;
+};
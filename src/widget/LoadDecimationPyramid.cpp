@@ -0,0 +1,141 @@
+#include "LoadDecimationPyramid.h"
+
+namespace {
+// 头部空闲超过该数量且过半时整体前移，避免 QVector 无限增长
+constexpr qsizetype kCompactThreshold = 256;
+// 桶存储的最小容量
+constexpr qsizetype kMinimumBuckets = 16;
+} // namespace
+
+LoadDecimationPyramid::LoadDecimationPyramid()
+    : m_levels(kLevelCount) {}
+
+void LoadDecimationPyramid::reset() {
+    for (Level &level : m_levels) {
+        level.buckets.clear();
+        level.head = 0;
+        level.firstIndex = 0;
+    }
+}
+
+bool LoadDecimationPyramid::append(qint64 sequence, qint64 timeMs, double value) {
+    bool grew = false;
+    for (int i = 0; i < kLevelCount; ++i) {
+        Level &level = m_levels[i];
+        const qint64 bucketIndex = sequence >> bucketShift(i + 1);
+        const qsizetype count = level.buckets.size() - level.head;
+        const qint64 lastIndex = level.firstIndex + count - 1;
+
+        if (count > 0 && bucketIndex == lastIndex) {
+            Bucket &bucket = level.buckets.last();
+            if (value < bucket.minValue) {
+                bucket.minValue = value;
+                bucket.minTime = timeMs;
+            }
+            if (value > bucket.maxValue) {
+                bucket.maxValue = value;
+                bucket.maxTime = timeMs;
+            }
+            continue;
+        }
+
+        // 序号不连续（如重置后）时从新桶重新开始
+        if (count == 0 || bucketIndex != lastIndex + 1) {
+            level.buckets.clear();
+            level.head = 0;
+            level.firstIndex = bucketIndex;
+        }
+        if (level.buckets.size() == level.buckets.capacity()) {
+            // 存储已满：头部有已丢弃的桶时先前移复用，否则容量倍增（与 growthBytes 的估计一致）
+            if (level.head > 0) {
+                level.buckets.remove(0, level.head);
+                level.head = 0;
+            } else {
+                level.buckets.reserve(qMax<qsizetype>(kMinimumBuckets, level.buckets.capacity() * 2));
+            }
+        }
+        const qsizetype capacity = level.buckets.capacity();
+        Bucket bucket;
+        bucket.minTime = timeMs;
+        bucket.minValue = value;
+        bucket.maxTime = timeMs;
+        bucket.maxValue = value;
+        level.buckets.append(bucket);
+        grew = grew || level.buckets.capacity() != capacity;
+    }
+    return grew;
+}
+
+void LoadDecimationPyramid::dropBefore(qint64 firstSequence) {
+    for (int i = 0; i < kLevelCount; ++i) {
+        Level &level = m_levels[i];
+        const int shift = bucketShift(i + 1);
+        while (level.head < level.buckets.size() && ((level.firstIndex + 1) << shift) <= firstSequence) {
+            ++level.head;
+            ++level.firstIndex;
+        }
+        if (level.head >= kCompactThreshold && level.head * 2 >= level.buckets.size()) {
+            level.buckets.remove(0, level.head);
+            level.head = 0;
+        }
+    }
+}
+
+void LoadDecimationPyramid::squeeze() {
+    for (Level &level : m_levels) {
+        level.buckets.remove(0, level.head);
+        level.head = 0;
+        level.buckets.squeeze();
+    }
+}
+
+qint64 LoadDecimationPyramid::memoryBytes() const {
+    qint64 bytes = 0;
+    for (const Level &level : m_levels) {
+        bytes += qint64(level.buckets.capacity()) * qint64(sizeof(Bucket));
+    }
+    return bytes;
+}
+
+qint64 LoadDecimationPyramid::growthBytes(qint64 sequence) const {
+    qint64 bytes = 0;
+    for (int i = 0; i < kLevelCount; ++i) {
+        const Level &level = m_levels.at(i);
+        const qint64 bucketIndex = sequence >> bucketShift(i + 1);
+        const qsizetype count = level.buckets.size() - level.head;
+        // 并入当前桶或可复用头部空间时不增长；序号不连续时从空存储重新开始
+        if (count > 0 && bucketIndex == level.firstIndex + count - 1) continue;
+        const bool restart = count == 0 || bucketIndex != level.firstIndex + count;
+        if (!restart && level.head > 0) continue;
+        const qsizetype capacity = level.buckets.capacity();
+        if ((restart ? 0 : level.buckets.size()) < capacity) continue;
+        bytes += qint64(qMax<qsizetype>(kMinimumBuckets, capacity * 2) - capacity) * qint64(sizeof(Bucket));
+    }
+    return bytes;
+}
+
+int LoadDecimationPyramid::levelFor(qsizetype sampleCount, qreal pixelWidth) {
+    const qsizetype columns = qMax<qsizetype>(1, static_cast<qsizetype>(pixelWidth));
+    // 原始样本不超过每像素 2 个时无需抽稀
+    if (sampleCount <= columns * 2) return 0;
+
+    for (int level = 1; level <= kLevelCount; ++level) {
+        // 每桶输出 2 个点：桶数不超过像素列数即每像素 1~2 个点
+        if ((sampleCount >> bucketShift(level)) + 1 <= columns) return level;
+    }
+    return kLevelCount;
+}
+
+qsizetype LoadDecimationPyramid::bucketCount(int level) const {
+    const Level &data = m_levels.at(level - 1);
+    return data.buckets.size() - data.head;
+}
+
+qint64 LoadDecimationPyramid::firstBucketIndex(int level) const {
+    return m_levels.at(level - 1).firstIndex;
+}
+
+const LoadDecimationPyramid::Bucket &LoadDecimationPyramid::bucketAt(int level, qsizetype index) const {
+    const Level &data = m_levels.at(level - 1);
+    return data.buckets.at(data.head + index);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+// 多分辨率最小/最大值聚合索引：随样本追加与裁剪增量维护。
+// 第 1 层每桶聚合 8 个原始样本，此后每层桶大小翻倍；桶按样本累计序号划分，
+// 渲染时选择桶数不超过像素宽度的最细层级，每桶输出最小/最大两个点，峰值不会丢失。
+class LoadDecimationPyramid {
+public:
+    struct Bucket {
+        qint64 minTime = 0;
+        double minValue = 0.0;
+        qint64 maxTime = 0;
+        double maxValue = 0.0;
+    };
+
+    static constexpr int kBaseBucketShift = 3;
+    static constexpr int kLevelCount = 16;
+
+    LoadDecimationPyramid();
+
+    // 清空全部层级
+    void reset();
+    // 返回 true 表示本次追加分配了新的桶存储
+    bool append(qint64 sequence, qint64 timeMs, double value);
+    // 丢弃完全位于 firstSequence 之前的桶
+    void dropBefore(qint64 firstSequence);
+    // 释放已丢弃的桶占用的存储
+    void squeeze();
+    // 各层桶存储占用的字节数（按已分配容量计）
+    qint64 memoryBytes() const;
+    // 追加序号为 sequence 的样本将新分配的字节数（新建桶且该层存储已满时按倍增估计）
+    qint64 growthBytes(qint64 sequence) const;
+
+    // 层级 level（1 起）的桶大小对应的移位量
+    static int bucketShift(int level) { return kBaseBucketShift + level - 1; }
+    // 根据样本数与像素宽度选择层级，0 表示直接使用原始样本
+    static int levelFor(qsizetype sampleCount, qreal pixelWidth);
+
+    qsizetype bucketCount(int level) const;
+    // 层级 level 首个桶的全局桶序号（桶序号 = 样本序号 >> bucketShift(level)）
+    qint64 firstBucketIndex(int level) const;
+    const Bucket &bucketAt(int level, qsizetype index) const;
+
+private:
+    struct Level {
+        QVector<Bucket> buckets;
+        qsizetype head = 0;
+        qint64 firstIndex = 0;
+    };
+
+    QVector<Level> m_levels;
+};
@@ -0,0 +1,126 @@
+#include "LoadFrameScheduler.h"
+#include "LoadTimelineModel.h"
+#include "LoadTimelineWidget.h"
+
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 随应用对象销毁；之后析构的控件不再访问调度器
+QPointer<LoadFrameScheduler> g_scheduler;
+
+template <typename T>
+void removeEntry(std::vector<QPointer<T>> &list, T *object) {
+    list.erase(std::remove_if(list.begin(), list.end(), [object](const QPointer<T> &entry) { return entry == object; }),
+               list.end());
+}
+} // namespace
+
+LoadFrameScheduler *LoadFrameScheduler::instance() {
+    if (!g_scheduler) {
+        g_scheduler = new LoadFrameScheduler(QCoreApplication::instance());
+    }
+    return g_scheduler;
+}
+
+LoadFrameScheduler::LoadFrameScheduler(QObject *parent)
+    : QObject(parent) {
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &LoadFrameScheduler::tick);
+    m_phase.start();
+}
+
+void LoadFrameScheduler::setFrameRate(double fps) {
+    m_frameRate = qMax(0.0, fps);
+}
+
+double LoadFrameScheduler::effectiveFrameRate() const {
+    if (m_frameRate > 0) return m_frameRate;
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    const double refreshRate = screen ? screen->refreshRate() : 0.0;
+    return refreshRate >= 1.0 ? refreshRate : 60.0;
+}
+
+void LoadFrameScheduler::requestFrame(LoadTimelineWidget *widget) {
+    widget->m_framePending = true;
+    m_pending.emplace_back(widget);
+    ensureRunning();
+}
+
+void LoadFrameScheduler::setDrainRequired(LoadTimelineModel *model, bool required) {
+    removeEntry(m_draining, model);
+    if (required) {
+        m_draining.emplace_back(model);
+        ensureRunning();
+    }
+}
+
+void LoadFrameScheduler::wake() {
+    QMetaObject::invokeMethod(this, &LoadFrameScheduler::ensureRunning, Qt::QueuedConnection);
+}
+
+void LoadFrameScheduler::release(LoadTimelineWidget *widget) {
+    if (!g_scheduler) return;
+    removeEntry(g_scheduler->m_pending, widget);
+}
+
+void LoadFrameScheduler::release(LoadTimelineModel *model) {
+    if (!g_scheduler) return;
+    removeEntry(g_scheduler->m_draining, model);
+}
+
+void LoadFrameScheduler::ensureRunning() {
+    if (m_timer.isActive()) return;
+    // 从空闲恢复时对齐到下一个网格点，各控件的请求落在同一拍
+    const double periodMs = 1000.0 / effectiveFrameRate();
+    const double nowMs = m_phase.nsecsElapsed() / 1e6;
+    m_nextTickMs = (std::floor(nowMs / periodMs) + 1.0) * periodMs;
+    scheduleNextTick();
+}
+
+void LoadFrameScheduler::scheduleNextTick() {
+    const double nowMs = m_phase.nsecsElapsed() / 1e6;
+    m_timer.start(qMax(0, static_cast<int>(std::lround(m_nextTickMs - nowMs))));
+}
+
+void LoadFrameScheduler::tick() {
+    ++m_tickCount;
+    const double periodMs = 1000.0 / effectiveFrameRate();
+
+    // 先取出生产者队列：新样本产生的重绘请求在本拍内一并派发。
+    // 遍历副本，取出过程中触发的信号可能增删模型与控件。队列均已挂起的模型不再推动节拍
+    const std::vector<QPointer<LoadTimelineModel>> draining = m_draining;
+    bool producing = false;
+    for (const QPointer<LoadTimelineModel> &model : draining) {
+        if (model && model->drainProducerQueues()) producing = true;
+    }
+
+    std::vector<QPointer<LoadTimelineWidget>> pending;
+    pending.swap(m_pending);
+    for (const QPointer<LoadTimelineWidget> &widget : pending) {
+        if (!widget || !widget->m_framePending) continue;
+        if (widget->frameDue(periodMs)) {
+            widget->m_framePending = false;
+            widget->update();
+            ++m_dispatchedFrames;
+        } else {
+            // 控件自身的 maxFrameRate 低于节拍帧率：留到下一拍
+            m_pending.push_back(widget);
+        }
+    }
+
+    if (m_pending.empty() && !producing) return;
+
+    // 按网格推进；处理耗时超过一拍时跳到下一个未来网格点，不补发落下的节拍
+    const double nowMs = m_phase.nsecsElapsed() / 1e6;
+    m_nextTickMs += periodMs;
+    if (m_nextTickMs <= nowMs) {
+        m_nextTickMs = (std::floor(nowMs / periodMs) + 1.0) * periodMs;
+    }
+    scheduleNextTick();
+}
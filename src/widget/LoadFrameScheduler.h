@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QtGlobal>
+
+#include <vector>
+
+class LoadTimelineModel;
+class LoadTimelineWidget;
+
+// 进程共享的帧调度器：所有控件由同一个按显示器刷新率对齐的节拍驱动。
+// 每拍先取出各数据模型的生产者队列，再只对有待绘制内容的控件调用 update()，
+// 同一窗口内的多个控件在同一次事件循环中合并绘制；没有待绘制控件且生产者队列均为空时节拍停止，进程可以空闲休眠，
+// 生产者向已挂起的空队列写入时再唤醒节拍。
+// 仅在 GUI 线程中使用。
+class LoadFrameScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    static LoadFrameScheduler *instance();
+
+    // 节拍帧率：0 表示跟随主屏幕刷新率（默认）
+    void setFrameRate(double fps);
+    double frameRate() const { return m_frameRate; }
+    // 实际使用的节拍帧率
+    double effectiveFrameRate() const;
+
+    // 运行统计：节拍数与派发的重绘次数
+    quint64 tickCount() const { return m_tickCount; }
+    quint64 dispatchedFrames() const { return m_dispatchedFrames; }
+
+private:
+    friend class LoadTimelineModel;
+    friend class LoadTimelineWidget;
+
+    explicit LoadFrameScheduler(QObject *parent = nullptr);
+
+    // 控件有新内容待绘制；同一拍内重复请求只记一次
+    void requestFrame(LoadTimelineWidget *widget);
+    // 模型持有生产者队列时登记，节拍运行时每拍取出一次
+    void setDrainRequired(LoadTimelineModel *model, bool required);
+    // 可在任意线程调用（生产者队列的唤醒回调）：排队到 GUI 线程恢复节拍
+    void wake();
+    // 控件与模型析构时调用；调度器尚未创建或已随应用销毁时不做任何事
+    static void release(LoadTimelineWidget *widget);
+    static void release(LoadTimelineModel *model);
+
+    void ensureRunning();
+    void scheduleNextTick();
+    void tick();
+
+    double m_frameRate = 0.0;
+    QTimer m_timer;
+    // 节拍相位：所有节拍落在以 m_phase 为起点、帧间隔为步长的网格上
+    QElapsedTimer m_phase;
+    double m_nextTickMs = 0.0;
+    std::vector<QPointer<LoadTimelineWidget>> m_pending;
+    std::vector<QPointer<LoadTimelineModel>> m_draining;
+    quint64 m_tickCount = 0;
+    quint64 m_dispatchedFrames = 0;
+};
@@ -0,0 +1,206 @@
+#include "LoadMappingKernel.h"
+
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LOAD_MAPPING_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define LOAD_MAPPING_TARGET_AVX2
+#else
+#define LOAD_MAPPING_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// SIMD 实现按 QPointF 为两个连续 double 的布局直接写出
+static_assert(std::is_same<qreal, double>::value, "mapping kernel requires qreal == double");
+static_assert(sizeof(QPointF) == 2 * sizeof(double), "unexpected QPointF layout");
+
+namespace {
+
+void mapScalar(const LoadMappingKernel::Transform &t, const qint64 *times, const double *values, qsizetype count,
+               QPointF *out) {
+    for (qsizetype i = 0; i < count; ++i) {
+        const double relative = double(times[i] - t.originMs);
+        const double ratioX = qBound(0.0, (relative - t.startOffsetMs) * t.invSpanMs, 1.0);
+        const double ratioY = qBound(0.0, (values[i] - t.loadMin) * t.invLoadRange, 1.0);
+        out[i] = QPointF(t.left + ratioX * t.width, t.bottom - ratioY * t.height);
+    }
+}
+
+#ifdef LOAD_MAPPING_X86_64
+
+// int64 → double：|x| < 2^51 时借助 0x1.8p52 的尾数位完成精确转换（AVX2 无直接指令）
+constexpr double kMagic = 6755399441055744.0;
+
+void mapSse2(const LoadMappingKernel::Transform &t, const qint64 *times, const double *values, qsizetype count,
+             QPointF *out) {
+    const __m128i origin = _mm_set1_epi64x(t.originMs);
+    const __m128d magic = _mm_set1_pd(kMagic);
+    const __m128d startOffset = _mm_set1_pd(t.startOffsetMs);
+    const __m128d invSpan = _mm_set1_pd(t.invSpanMs);
+    const __m128d left = _mm_set1_pd(t.left);
+    const __m128d width = _mm_set1_pd(t.width);
+    const __m128d loadMin = _mm_set1_pd(t.loadMin);
+    const __m128d invLoadRange = _mm_set1_pd(t.invLoadRange);
+    const __m128d bottom = _mm_set1_pd(t.bottom);
+    const __m128d height = _mm_set1_pd(t.height);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    double *dst = reinterpret_cast<double *>(out);
+
+    qsizetype i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128i relative = _mm_sub_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(times + i)), origin);
+        const __m128d relativeMs =
+            _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(relative, _mm_castpd_si128(magic))), magic);
+        // 与 qBound(0, r, 1) 相同的比较顺序：NaN 钳制为 0
+        __m128d ratioX = _mm_mul_pd(_mm_sub_pd(relativeMs, startOffset), invSpan);
+        ratioX = _mm_max_pd(_mm_min_pd(one, ratioX), zero);
+        __m128d ratioY = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(values + i), loadMin), invLoadRange);
+        ratioY = _mm_max_pd(_mm_min_pd(one, ratioY), zero);
+
+        const __m128d x = _mm_add_pd(left, _mm_mul_pd(ratioX, width));
+        const __m128d y = _mm_sub_pd(bottom, _mm_mul_pd(ratioY, height));
+        _mm_storeu_pd(dst + 2 * i, _mm_unpacklo_pd(x, y));
+        _mm_storeu_pd(dst + 2 * i + 2, _mm_unpackhi_pd(x, y));
+    }
+    mapScalar(t, times + i, values + i, count - i, out + i);
+}
+
+LOAD_MAPPING_TARGET_AVX2
+void mapAvx2(const LoadMappingKernel::Transform &t, const qint64 *times, const double *values, qsizetype count,
+             QPointF *out) {
+    const __m256i origin = _mm256_set1_epi64x(t.originMs);
+    const __m256d magic = _mm256_set1_pd(kMagic);
+    const __m256d startOffset = _mm256_set1_pd(t.startOffsetMs);
+    const __m256d invSpan = _mm256_set1_pd(t.invSpanMs);
+    const __m256d left = _mm256_set1_pd(t.left);
+    const __m256d width = _mm256_set1_pd(t.width);
+    const __m256d loadMin = _mm256_set1_pd(t.loadMin);
+    const __m256d invLoadRange = _mm256_set1_pd(t.invLoadRange);
+    const __m256d bottom = _mm256_set1_pd(t.bottom);
+    const __m256d height = _mm256_set1_pd(t.height);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    double *dst = reinterpret_cast<double *>(out);
+
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i relative =
+            _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(times + i)), origin);
+        const __m256d relativeMs =
+            _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(relative, _mm256_castpd_si256(magic))), magic);
+        __m256d ratioX = _mm256_mul_pd(_mm256_sub_pd(relativeMs, startOffset), invSpan);
+        ratioX = _mm256_max_pd(_mm256_min_pd(one, ratioX), zero);
+        __m256d ratioY = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(values + i), loadMin), invLoadRange);
+        ratioY = _mm256_max_pd(_mm256_min_pd(one, ratioY), zero);
+
+        const __m256d x = _mm256_add_pd(left, _mm256_mul_pd(ratioX, width));
+        const __m256d y = _mm256_sub_pd(bottom, _mm256_mul_pd(ratioY, height));
+        // (x0,y0,x2,y2) / (x1,y1,x3,y3) → (x0,y0,x1,y1) / (x2,y2,x3,y3)
+        const __m256d low = _mm256_unpacklo_pd(x, y);
+        const __m256d high = _mm256_unpackhi_pd(x, y);
+        _mm256_storeu_pd(dst + 2 * i, _mm256_permute2f128_pd(low, high, 0x20));
+        _mm256_storeu_pd(dst + 2 * i + 4, _mm256_permute2f128_pd(low, high, 0x31));
+    }
+    mapScalar(t, times + i, values + i, count - i, out + i);
+}
+
+bool detectAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    // 操作系统须保存 YMM 寄存器状态
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // LOAD_MAPPING_X86_64
+
+} // namespace
+
+LoadMappingKernel::Transform LoadMappingKernel::makeTransform(double nowMs, int windowSeconds, double loadMin,
+                                                              double loadMax, const QRectF &area) {
+    Transform t;
+    t.originMs = static_cast<qint64>(nowMs);
+    const double spanMs = windowSeconds * 1000.0;
+    t.startOffsetMs = (nowMs - double(t.originMs)) - spanMs;
+    t.invSpanMs = 1.0 / spanMs;
+    t.left = area.left();
+    t.width = area.width();
+    t.loadMin = loadMin;
+    t.invLoadRange = 1.0 / (loadMax - loadMin);
+    t.bottom = area.bottom();
+    t.height = area.height();
+    return t;
+}
+
+void LoadMappingKernel::map(const Transform &transform, const qint64 *times, const double *values, qsizetype count,
+                            QPointF *out) {
+    static const Isa isa = activeIsa();
+    mapWith(isa, transform, times, values, count, out);
+}
+
+void LoadMappingKernel::mapWith(Isa isa, const Transform &transform, const qint64 *times, const double *values,
+                                qsizetype count, QPointF *out) {
+    if (count <= 0) return;
+#ifdef LOAD_MAPPING_X86_64
+    if (isa == Avx2Isa && isSupported(Avx2Isa)) {
+        mapAvx2(transform, times, values, count, out);
+        return;
+    }
+    if (isa == Sse2Isa) {
+        mapSse2(transform, times, values, count, out);
+        return;
+    }
+#else
+    Q_UNUSED(isa);
+#endif
+    mapScalar(transform, times, values, count, out);
+}
+
+LoadMappingKernel::Isa LoadMappingKernel::activeIsa() {
+    if (isSupported(Avx2Isa)) return Avx2Isa;
+    if (isSupported(Sse2Isa)) return Sse2Isa;
+    return ScalarIsa;
+}
+
+bool LoadMappingKernel::isSupported(Isa isa) {
+#ifdef LOAD_MAPPING_X86_64
+    static const bool avx2 = detectAvx2();
+    switch (isa) {
+    case Avx2Isa:
+        return avx2;
+    case Sse2Isa:
+        return true; // x86-64 基线
+    case ScalarIsa:
+        return true;
+    }
+    return false;
+#else
+    return isa == ScalarIsa;
+#endif
+}
+
+const char *LoadMappingKernel::isaName(Isa isa) {
+    switch (isa) {
+    case Avx2Isa:
+        return "avx2";
+    case Sse2Isa:
+        return "sse2";
+    case ScalarIsa:
+        break;
+    }
+    return "scalar";
+}
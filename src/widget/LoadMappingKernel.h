@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QPointF>
+#include <QRectF>
+#include <QtGlobal>
+
+// 样本到像素坐标的批量映射内核：把连续的时间戳/负荷值数组一次性映射为图表坐标，
+// 并钳制到图表区域内。按运行时检测到的指令集选择 AVX2 / SSE2 / 标量实现，
+// 各实现使用相同的运算顺序，结果与标量实现一致。
+class LoadMappingKernel {
+public:
+    enum Isa {
+        ScalarIsa = 0,
+        Sse2Isa = 1,
+        Avx2Isa = 2
+    };
+
+    // 预先算好的映射参数：时间先减去整数基准再转为 double，避免大时间戳损失精度
+    struct Transform {
+        qint64 originMs = 0;
+        double startOffsetMs = 0.0; // 图表左缘相对基准的毫秒数
+        double invSpanMs = 0.0;
+        double left = 0.0;
+        double width = 0.0;
+        double loadMin = 0.0;
+        double invLoadRange = 0.0;
+        double bottom = 0.0;
+        double height = 0.0;
+    };
+
+    // 相对时间轴：nowMs 对应图表右缘，时间窗口 windowSeconds 对应图表宽度
+    static Transform makeTransform(double nowMs, int windowSeconds, double loadMin, double loadMax, const QRectF &area);
+
+    // 映射 count 个样本到 out；要求 |times[i] - originMs| < 2^51
+    static void map(const Transform &transform, const qint64 *times, const double *values, qsizetype count,
+                    QPointF *out);
+    // 指定实现（用于校验与基准）；不支持的实现退回标量
+    static void mapWith(Isa isa, const Transform &transform, const qint64 *times, const double *values,
+                        qsizetype count, QPointF *out);
+
+    static Isa activeIsa();
+    static bool isSupported(Isa isa);
+    static const char *isaName(Isa isa);
+};
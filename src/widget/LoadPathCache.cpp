@@ -0,0 +1,305 @@
+#include "LoadPathCache.h"
+#include "LoadDecimationPyramid.h"
+#include "LoadSampleBuffer.h"
+#include "LoadTimelineRenderer.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+QPointF lerp(const QPointF &a, const QPointF &b, double t) {
+    return a + (b - a) * t;
+}
+
+// 平滑片段的纵向分量为 y0 + (y1 - y0)·(3s² - 2s³)，反解该三次式得到纵向比例 f 对应的贝塞尔参数
+double smoothstepInverse(double f) {
+    return 0.5 - qSin(qAsin(qBound(-1.0, 1.0 - 2.0 * f, 1.0)) / 3.0);
+}
+} // namespace
+
+void LoadPathCache::sync(const LoadSampleBuffer &buffer, const LoadDecimationPyramid &pyramid,
+                         const Geometry &geometry, qint64 windowStartMs) {
+    const ZonePaths previousTail = std::move(m_tail);
+    m_tail = ZonePaths();
+    // 层级按窗口内的样本数选择：缓冲区可能保留了更长的数据（数据模型与更宽的视图共用）
+    const qsizetype visible = buffer.size() - buffer.lowerBound(windowStartMs);
+    const int target = LoadDecimationPyramid::levelFor(visible, geometry.area.width());
+    // 样本数在层级边界附近波动时沿用当前层级，避免每帧重建：
+    // 允许粗一级；细一级时点数不超过每像素 4 个
+    const qsizetype columns = qMax<qsizetype>(1, static_cast<qsizetype>(geometry.area.width()));
+    const qsizetype cachedPoints = m_level == 0
+        ? visible
+        : 2 * ((visible >> LoadDecimationPyramid::bucketShift(m_level)) + 1);
+    const bool levelUsable = m_level == target || m_level == target + 1
+        || (m_level == target - 1 && cachedPoints <= columns * 4);
+    if (!m_valid || geometry != m_geometry || !levelUsable) {
+        rebuild(geometry, target, target == 0 ? buffer.firstSequence() : 0);
+    }
+    if (buffer.isEmpty()) return;
+    if (!m_hasLast) {
+        // 基准时刻取首个绘制样本，路径坐标保持在较小的数值范围
+        m_originMs = buffer.firstTime();
+    }
+
+    const qint64 endSequence = buffer.firstSequence() + buffer.size();
+    if (m_level == 0) {
+        // 已裁剪但尚未绘制的样本直接跳过
+        qint64 seq = qMax(m_next, buffer.firstSequence());
+        if (!m_hasLast) {
+            // 重建时跳过窗口之前的样本，只保留紧邻窗口的一个以连接左缘
+            while (seq + 1 < endSequence && buffer.timeAt(seq + 1 - buffer.firstSequence()) < windowStartMs) {
+                ++seq;
+            }
+        }
+        for (; seq < endSequence; ++seq) {
+            const qsizetype index = seq - buffer.firstSequence();
+            addPoint(buffer.timeAt(index), buffer.valueAt(index));
+        }
+        m_next = endSequence;
+    } else {
+        // 只有写满的桶进入缓存路径，未写满的桶每次同步时放入尾段
+        const int shift = LoadDecimationPyramid::bucketShift(m_level);
+        const qint64 firstBucket = pyramid.firstBucketIndex(m_level);
+        const qint64 bucketEnd = firstBucket + pyramid.bucketCount(m_level);
+        const qint64 completeEnd = qMin(bucketEnd, endSequence >> shift);
+        qint64 index = qMax(m_next, firstBucket);
+        if (!m_hasLast) {
+            while (index + 1 < completeEnd) {
+                const LoadDecimationPyramid::Bucket &next = pyramid.bucketAt(m_level, index + 1 - firstBucket);
+                if (qMin(next.minTime, next.maxTime) >= windowStartMs) break;
+                ++index;
+            }
+        }
+        for (; index < completeEnd; ++index) {
+            const LoadDecimationPyramid::Bucket &bucket = pyramid.bucketAt(m_level, index - firstBucket);
+            addExtrema(bucket.minTime, bucket.minValue, bucket.maxTime, bucket.maxValue);
+        }
+        m_next = qMax(m_next, completeEnd);
+
+        QPointF tailPoints[3];
+        int tailCount = 0;
+        if (completeEnd < bucketEnd) {
+            const LoadDecimationPyramid::Bucket &bucket = pyramid.bucketAt(m_level, completeEnd - firstBucket);
+            const bool minFirst = bucket.minTime <= bucket.maxTime;
+            tailPoints[tailCount++] = toPathPoint(minFirst ? bucket.minTime : bucket.maxTime,
+                                                  minFirst ? bucket.minValue : bucket.maxValue);
+            if (bucket.minTime != bucket.maxTime) {
+                tailPoints[tailCount++] = toPathPoint(minFirst ? bucket.maxTime : bucket.minTime,
+                                                      minFirst ? bucket.maxValue : bucket.minValue);
+            }
+        }
+        // 曲线末端始终落在最新样本上
+        const QPointF last = toPathPoint(buffer.lastTime(), buffer.lastValue());
+        if (tailCount == 0 ? (!m_hasLast || m_lastPoint != last) : tailPoints[tailCount - 1] != last) {
+            tailPoints[tailCount++] = last;
+        }
+
+        if (tailCount > 0) {
+            QPointF previous = m_hasLast ? m_lastPoint : tailPoints[0];
+            for (int i = m_hasLast ? 0 : 1; i < tailCount; ++i) {
+                appendSegment(m_tail, previous, tailPoints[i]);
+                previous = tailPoints[i];
+            }
+        }
+    }
+
+    // 丢弃完全位于窗口之外的分块（保留最后一块以便继续追加）
+    qsizetype expired = 0;
+    while (expired + 1 < m_chunks.size() && m_chunks.at(expired).maxTime < windowStartMs) {
+        ++expired;
+    }
+    if (expired > 0) {
+        m_chunks.remove(0, expired);
+        rejoinChunks();
+    }
+    updateStrokePaths(previousTail);
+}
+
+void LoadPathCache::rebuildFromPoints(const qint64 *times, const double *values, qsizetype count,
+                                      const Geometry &geometry, qint64 originMs) {
+    m_tail = ZonePaths();
+    rebuild(geometry, 0, 0);
+    m_originMs = originMs;
+    for (qsizetype i = 0; i < count; ++i) {
+        addPoint(times[i], values[i]);
+    }
+}
+
+void LoadPathCache::rebuild(const Geometry &geometry, int level, qint64 next) {
+    m_chunks.clear();
+    m_running = ZonePaths();
+    m_runningChanged = true;
+    m_geometry = geometry;
+    m_level = level;
+    m_valid = true;
+    m_hasLast = false;
+    m_pxPerMs = geometry.windowSeconds > 0 ? geometry.area.width() / (geometry.windowSeconds * 1000.0) : 0.0;
+    m_next = next;
+    m_splitter = ZoneSplitter::forThresholds(geometry.area, geometry.loadMin, geometry.loadMax,
+                                             geometry.mediumThreshold, geometry.highThreshold, geometry.smoothing);
+}
+
+void LoadPathCache::rejoinChunks() {
+    // 丢弃分块后由剩余分块重新拼接常驻路径：每个分块的路径以 moveTo 开始，拼接结果与逐段追加的几何一致
+    m_running = ZonePaths();
+    for (const Chunk &chunk : m_chunks) {
+        for (int zone = 0; zone < kZoneCount; ++zone) {
+            if (!chunk.zones.hasEnd[zone]) continue;
+            m_running.paths[zone].addPath(chunk.zones.paths[zone]);
+            m_running.end[zone] = chunk.zones.end[zone];
+            m_running.hasEnd[zone] = true;
+        }
+    }
+    m_runningChanged = true;
+}
+
+void LoadPathCache::updateStrokePaths(const ZonePaths &previousTail) {
+    for (int zone = 0; zone < kZoneCount; ++zone) {
+        if (m_tail.paths[zone].isEmpty()) {
+            m_stroke[zone] = QPainterPath();
+        } else if (m_runningChanged || m_tail.paths[zone] != previousTail.paths[zone]) {
+            m_stroke[zone] = m_running.paths[zone];
+            m_stroke[zone].addPath(m_tail.paths[zone]);
+        }
+    }
+    m_runningChanged = false;
+}
+
+QPointF LoadPathCache::toPathPoint(qint64 timeMs, double value) const {
+    const QRectF &area = m_geometry.area;
+    const double loadRange = m_geometry.loadMax - m_geometry.loadMin;
+    const double ratioY = qBound(0.0, (value - m_geometry.loadMin) / loadRange, 1.0);
+    return QPointF(double(timeMs - m_originMs) * m_pxPerMs, area.bottom() - ratioY * area.height());
+}
+
+void LoadPathCache::addPoint(qint64 timeMs, double value) {
+    const QPointF point = toPathPoint(timeMs, value);
+    if (m_chunks.isEmpty() || m_chunks.constLast().pointCount >= kChunkPoints) {
+        // 新分块的首段从上一块的末点开始，保证曲线连续；分区着色时各分区路径同样按块切分
+        Chunk chunk;
+        chunk.maxTime = timeMs;
+        chunk.pointCount = 1;
+        m_chunks.append(chunk);
+    }
+
+    Chunk &chunk = m_chunks.last();
+    if (m_hasLast) {
+        appendSegment(chunk.zones, m_lastPoint, point);
+        appendSegment(m_running, m_lastPoint, point);
+        m_runningChanged = true;
+        ++chunk.pointCount;
+    }
+    chunk.maxTime = qMax(chunk.maxTime, timeMs);
+    m_lastPoint = point;
+    m_hasLast = true;
+}
+
+void LoadPathCache::addExtrema(qint64 minTime, double minValue, qint64 maxTime, double maxValue) {
+    // 每桶按时间先后输出最小/最大两个点，保证峰值可见
+    if (minTime == maxTime) {
+        addPoint(minTime, minValue);
+    } else if (minTime < maxTime) {
+        addPoint(minTime, minValue);
+        addPoint(maxTime, maxValue);
+    } else {
+        addPoint(maxTime, maxValue);
+        addPoint(minTime, minValue);
+    }
+}
+
+void LoadPathCache::appendSegment(ZonePaths &target, const QPointF &from, const QPointF &to) const {
+    if (m_geometry.zoneColoring) {
+        m_splitter.appendSegment(target, from, to);
+        return;
+    }
+    if (!target.hasEnd[0] || target.end[0] != from) {
+        target.paths[0].moveTo(from);
+    }
+    LoadTimelineRenderer::appendSegment(target.paths[0], from, to, m_geometry.smoothing);
+    target.end[0] = to;
+    target.hasEnd[0] = true;
+}
+
+LoadPathCache::ZoneSplitter LoadPathCache::ZoneSplitter::forThresholds(const QRectF &area, double loadMin,
+                                                                      double loadMax, double medium, double high,
+                                                                      bool smoothing) {
+    ZoneSplitter splitter;
+    const double loadRange = loadMax - loadMin;
+    splitter.mediumY = area.bottom() - (medium - loadMin) / loadRange * area.height();
+    splitter.highY = area.bottom() - (high - loadMin) / loadRange * area.height();
+    splitter.smoothing = smoothing;
+    return splitter;
+}
+
+void LoadPathCache::ZoneSplitter::appendSegment(ZonePaths &target, const QPointF &from, const QPointF &to) const {
+    // 片段纵向单调，每条阈值线至多穿越一次；求出穿越处的参数并按先后排序
+    double params[2];
+    int crossings = 0;
+    for (const double thresholdY : {mediumY, highY}) {
+        if ((from.y() - thresholdY) * (to.y() - thresholdY) >= 0.0) continue;
+        const double f = (thresholdY - from.y()) / (to.y() - from.y());
+        params[crossings++] = smoothing ? smoothstepInverse(f) : f;
+    }
+    if (crossings == 2 && params[0] > params[1]) {
+        std::swap(params[0], params[1]);
+    }
+
+    // 同一分区的相邻片段首尾相接时延续当前子路径
+    auto emitPiece = [&](const QPointF &start, const QPointF &c1, const QPointF &c2, const QPointF &end) {
+        const int zone = zoneForY((start.y() + end.y()) * 0.5);
+        QPainterPath &path = target.paths[zone];
+        if (!target.hasEnd[zone] || target.end[zone] != start) {
+            path.moveTo(start);
+        }
+        if (smoothing) {
+            path.cubicTo(c1, c2, end);
+        } else {
+            path.lineTo(end);
+        }
+        target.end[zone] = end;
+        target.hasEnd[zone] = true;
+    };
+
+    if (!smoothing) {
+        QPointF start = from;
+        for (int i = 0; i < crossings; ++i) {
+            const QPointF split = lerp(from, to, params[i]);
+            emitPiece(start, start, split, split);
+            start = split;
+        }
+        emitPiece(start, start, to, to);
+        return;
+    }
+
+    // 与 LoadTimelineRenderer::appendSegment 相同的控制点，按 de Casteljau 依次切分
+    const double midX = (from.x() + to.x()) / 2.0;
+    QPointF p0 = from;
+    QPointF p1(midX, from.y());
+    QPointF p2(midX, to.y());
+    const QPointF p3 = to;
+    double consumed = 0.0;
+    for (int i = 0; i < crossings; ++i) {
+        const double s = (params[i] - consumed) / (1.0 - consumed);
+        const QPointF p01 = lerp(p0, p1, s);
+        const QPointF p12 = lerp(p1, p2, s);
+        const QPointF p23 = lerp(p2, p3, s);
+        const QPointF p012 = lerp(p01, p12, s);
+        const QPointF p123 = lerp(p12, p23, s);
+        const QPointF split = lerp(p012, p123, s);
+        emitPiece(p0, p01, p012, split);
+        p0 = split;
+        p1 = p123;
+        p2 = p23;
+        consumed = params[i];
+    }
+    emitPiece(p0, p1, p2, p3);
+}
+
+int LoadPathCache::ZoneSplitter::zoneForY(double y) const {
+    // 与 LoadTimelineRenderer::colorForLoad 一致：达到阈值即归入较高分区（像素纵坐标向下递增）
+    if (y <= highY) return 2;
+    if (y <= mediumY) return 1;
+    return 0;
+}
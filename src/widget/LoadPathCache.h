@@ -0,0 +1,125 @@
+#pragma once
+
+#include <QPainterPath>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include <QtGlobal>
+
+class LoadDecimationPyramid;
+class LoadSampleBuffer;
+
+// 曲线路径缓存：路径按时间相对坐标保存（x = (t - 基准时刻) × 每毫秒像素数，y 为图表像素），
+// 时间推进只改变绘制时的平移量。新样本只追加新片段；路径按固定点数分块，
+// 整块离开时间窗口后直接丢弃。只有图表几何、纵轴范围、平滑开关或抽稀层级变化时才整体重建。
+//
+// 分块只用于丢弃：各分块的路径同时追加到一条常驻描边路径（每个分区一条），分块被丢弃时由剩余分块重新拼接，
+// 每条序列每帧每个分区只需一次描边调用。
+//
+// 分区着色模式：每段曲线在阈值穿越处精确切分（平滑曲线按贝塞尔参数切分），
+// 同一分区的片段汇入同一条路径；单色模式只使用分区 0。
+class LoadPathCache {
+public:
+    static constexpr int kZoneCount = 3;
+
+    // 按分区归集的路径及各自的末点，片段不相接时另起子路径
+    struct ZonePaths {
+        QPainterPath paths[kZoneCount];
+        QPointF end[kZoneCount];
+        bool hasEnd[kZoneCount] = {};
+    };
+
+    // 分区切分：片段在阈值穿越处切分后按分区汇入 ZonePaths，阈值以像素纵坐标给出（不钳制）。
+    // 切分只取决于纵坐标，整体平移不改变切分点：缓存路径、滚动贴图与异步绘制共用，各模式的分区颜色一致
+    struct ZoneSplitter {
+        double mediumY = 0.0;
+        double highY = 0.0;
+        bool smoothing = false;
+
+        static ZoneSplitter forThresholds(const QRectF &area, double loadMin, double loadMax, double medium,
+                                          double high, bool smoothing);
+        void appendSegment(ZonePaths &target, const QPointF &from, const QPointF &to) const;
+        // 达到阈值即归入较高分区（像素纵坐标向下递增）
+        int zoneForY(double y) const;
+    };
+
+    // 影响路径几何的参数，任一变化即整体重建
+    struct Geometry {
+        QRectF area;
+        int windowSeconds = 0;
+        double loadMin = 0.0;
+        double loadMax = 0.0;
+        bool smoothing = false;
+        bool zoneColoring = false;
+        double mediumThreshold = 0.0;
+        double highThreshold = 0.0;
+        quint64 dataGeneration = 0;
+
+        bool operator==(const Geometry &other) const {
+            return area == other.area && windowSeconds == other.windowSeconds && loadMin == other.loadMin
+                && loadMax == other.loadMax && smoothing == other.smoothing && zoneColoring == other.zoneColoring
+                && (!zoneColoring
+                    || (mediumThreshold == other.mediumThreshold && highThreshold == other.highThreshold))
+                && dataGeneration == other.dataGeneration;
+        }
+        bool operator!=(const Geometry &other) const { return !(*this == other); }
+    };
+
+    // 每块的最大点数：块越小裁剪越及时，块越大丢弃时重新拼接的次数越少
+    static constexpr int kChunkPoints = 512;
+
+    void invalidate() { m_valid = false; }
+
+    // 与缓冲区当前内容同步：追加新样本（或新完成的抽稀桶），丢弃完全早于 windowStartMs 的分块
+    void sync(const LoadSampleBuffer &buffer, const LoadDecimationPyramid &pyramid, const Geometry &geometry,
+              qint64 windowStartMs);
+
+    // 以时间有序的点序列整体重建（分层保留的汇总数据），不参与增量同步；originMs 为路径坐标基准
+    void rebuildFromPoints(const qint64 *times, const double *values, qsizetype count, const Geometry &geometry,
+                           qint64 originMs);
+    const Geometry &geometry() const { return m_geometry; }
+    bool isValid() const { return m_valid; }
+
+    // 绘制时的水平平移：nowMs 对应图表右缘
+    double offsetX(double nowMs) const { return m_geometry.area.right() - (nowMs - m_originMs) * m_pxPerMs; }
+
+    // 分区的完整描边路径（全部分块与尾段），单色模式只使用分区 0。
+    // 尾段（抽稀层级下未写满的桶与最新样本，仅数个点）为空时直接返回常驻路径；
+    // 否则返回常驻路径加尾段的副本，只在同步时数据发生变化才重新生成
+    const QPainterPath &strokePath(int zone = 0) const {
+        return m_tail.paths[zone].isEmpty() ? m_running.paths[zone] : m_stroke[zone];
+    }
+    bool isEmpty() const { return m_chunks.isEmpty(); }
+
+private:
+    struct Chunk {
+        ZonePaths zones;
+        qint64 maxTime = 0;
+        int pointCount = 0;
+    };
+
+    void rebuild(const Geometry &geometry, int level, qint64 next);
+    QPointF toPathPoint(qint64 timeMs, double value) const;
+    void addPoint(qint64 timeMs, double value);
+    void addExtrema(qint64 minTime, double minValue, qint64 maxTime, double maxValue);
+    void appendSegment(ZonePaths &target, const QPointF &from, const QPointF &to) const;
+    void rejoinChunks();
+    void updateStrokePaths(const ZonePaths &previousTail);
+
+    QVector<Chunk> m_chunks;
+    // 全部分块按先后拼接的常驻路径：新片段同时追加到所在分块与此处
+    ZonePaths m_running;
+    ZonePaths m_tail;
+    QPainterPath m_stroke[kZoneCount];
+    bool m_runningChanged = false;
+    Geometry m_geometry;
+    bool m_valid = false;
+    int m_level = 0;
+    qint64 m_originMs = 0;
+    double m_pxPerMs = 0.0;
+    ZoneSplitter m_splitter;
+    // 下一个待追加的样本序号（原始层级）或全局桶序号（抽稀层级）
+    qint64 m_next = 0;
+    QPointF m_lastPoint;
+    bool m_hasLast = false;
+};
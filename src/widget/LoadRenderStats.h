@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QMetaType>
+#include <QtGlobal>
+
+// 绘制与数据接入的运行统计：分阶段耗时、帧数、接入速率与缓冲占用。
+// 阶段耗时在一帧内累加，帧结束时写入“上一帧”并更新指数滑动平均。
+struct LoadRenderStats {
+    enum Phase {
+        FramePhase = 0,   // paintEvent 总耗时
+        ZonesPhase,       // drawThresholdZones（仅背景缓存失效时）
+        AxisPhase,        // drawAxis（仅背景缓存失效时）
+        MapPhase,         // 样本到像素坐标映射
+        PathPhase,        // 路径构建
+        StrokePhase,      // 曲线描边与贴图
+        OverlayPhase,     // 当前值标签等叠加层
+        PhaseCount
+    };
+
+    double lastPhaseNs[PhaseCount] = {};
+    double averagePhaseNs[PhaseCount] = {};
+
+    quint64 framesRendered = 0;
+    // 因帧率限制被合并掉的重绘请求数
+    quint64 framesSkipped = 0;
+    // 异步绘制时工作线程落后而被替换的快照数
+    quint64 framesDropped = 0;
+    quint64 samplesIngested = 0;
+    double framesPerSecond = 0.0;
+    double samplesPerSecond = 0.0;
+    qsizetype bufferedSamples = 0;
+    qsizetype bufferCapacity = 0;
+
+    void addPhase(Phase phase, qint64 ns) { m_frameNs[phase] += ns; }
+    void commitFrame() {
+        for (int i = 0; i < PhaseCount; ++i) {
+            lastPhaseNs[i] = m_frameNs[i];
+            averagePhaseNs[i] = framesRendered == 0 ? m_frameNs[i] : averagePhaseNs[i] * 0.9 + m_frameNs[i] * 0.1;
+            m_frameNs[i] = 0.0;
+        }
+        ++framesRendered;
+    }
+
+    static const char *phaseName(Phase phase) {
+        static const char *const names[PhaseCount] = {"frame", "zones", "axis", "map", "path", "stroke", "overlay"};
+        return names[phase];
+    }
+
+private:
+    double m_frameNs[PhaseCount] = {};
+};
+
+Q_DECLARE_METATYPE(LoadRenderStats)
+
+// 阶段计时作用域：统计对象为空（未启用统计）时不做任何计时
+class LoadPhaseScope {
+public:
+    LoadPhaseScope(LoadRenderStats *stats, LoadRenderStats::Phase phase)
+        : m_stats(stats), m_phase(phase) {
+        if (m_stats) m_timer.start();
+    }
+    ~LoadPhaseScope() {
+        if (m_stats) m_stats->addPhase(m_phase, m_timer.nsecsElapsed());
+    }
+
+    LoadPhaseScope(const LoadPhaseScope &) = delete;
+    LoadPhaseScope &operator=(const LoadPhaseScope &) = delete;
+
+private:
+    LoadRenderStats *m_stats;
+    LoadRenderStats::Phase m_phase;
+    QElapsedTimer m_timer;
+};
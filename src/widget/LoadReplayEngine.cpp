@@ -0,0 +1,154 @@
+#include "LoadReplayEngine.h"
+#include "LoadSessionArchive.h"
+#include "LoadTimelineWidget.h"
+
+#include <cmath>
+
+namespace {
+// 单次送入控件的最大样本数：高倍速下分批追加，避免单批占用过多临时内存
+constexpr qsizetype kMaxBatch = 65536;
+} // namespace
+
+LoadReplayEngine::LoadReplayEngine(QObject *parent)
+    : QObject(parent), m_clock(std::make_shared<LoadVirtualClock>()) {
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &LoadReplayEngine::tick);
+}
+
+LoadReplayEngine::~LoadReplayEngine() {
+    restoreTargetClock();
+}
+
+bool LoadReplayEngine::open(const QString &path) {
+    auto archive = std::make_unique<LoadSessionArchive>();
+    if (!archive->open(path)) return false;
+
+    pause();
+    m_archive = std::move(archive);
+    seek(m_archive->startTime());
+    return true;
+}
+
+void LoadReplayEngine::close() {
+    pause();
+    m_archive.reset();
+    m_nextIndex = 0;
+}
+
+void LoadReplayEngine::setTarget(LoadTimelineWidget *widget, int seriesId) {
+    restoreTargetClock();
+    m_widget = widget;
+    m_seriesId = seriesId;
+    if (!widget) return;
+
+    m_targetClock = widget->clock();
+    widget->setClock(m_clock);
+    if (m_archive) {
+        seek(positionMs());
+    }
+}
+
+void LoadReplayEngine::restoreTargetClock() {
+    if (m_widget && m_widget->clock() == m_clock) {
+        m_widget->setClock(m_targetClock);
+    }
+    m_targetClock.reset();
+}
+
+void LoadReplayEngine::setFrameIntervalMs(int ms) {
+    m_frameIntervalMs = qMax(1, ms);
+    if (m_timer.isActive()) {
+        m_timer.setInterval(m_frameIntervalMs);
+    }
+}
+
+qint64 LoadReplayEngine::startMs() const {
+    return m_archive ? m_archive->startTime() : 0;
+}
+
+qint64 LoadReplayEngine::endMs() const {
+    return m_archive ? m_archive->endTime() : 0;
+}
+
+void LoadReplayEngine::play() {
+    if (!m_archive || m_timer.isActive()) return;
+    if (positionMs() >= endMs()) {
+        seek(startMs());
+    }
+    m_carryMs = 0.0;
+    m_wallClock.start();
+    m_timer.start(m_frameIntervalMs);
+    emit playingChanged(true);
+}
+
+void LoadReplayEngine::pause() {
+    if (!m_timer.isActive()) return;
+    m_timer.stop();
+    emit playingChanged(false);
+}
+
+void LoadReplayEngine::stepFrame() {
+    pause();
+    if (!m_archive) return;
+    advanceTo(positionMs() + qRound64(m_frameIntervalMs * m_speed));
+}
+
+void LoadReplayEngine::seek(qint64 timeMs) {
+    if (!m_archive) return;
+    timeMs = qBound(startMs(), timeMs, endMs());
+
+    // 从目标时刻之前一个时间窗口处开始重新送入，图表内容与连续播放到该时刻一致
+    qint64 windowMs = 0;
+    if (m_widget) {
+        m_widget->setSeriesSamples(m_seriesId, {});
+        windowMs = qint64(m_widget->timeWindowSeconds()) * 1000;
+    }
+    m_nextIndex = m_archive->lowerBound(timeMs - windowMs);
+    advanceTo(timeMs);
+}
+
+void LoadReplayEngine::setSpeed(double speed) {
+    speed = qBound(MinSpeed, speed, MaxSpeed);
+    if (qFuzzyCompare(speed, m_speed)) return;
+    m_speed = speed;
+    emit speedChanged(speed);
+}
+
+void LoadReplayEngine::tick() {
+    // 按实际流逝时间换算虚拟时间，定时器抖动不会累积为回放误差
+    const double advanceMs = m_wallClock.restart() * m_speed + m_carryMs;
+    const qint64 wholeMs = static_cast<qint64>(std::floor(advanceMs));
+    m_carryMs = advanceMs - wholeMs;
+    advanceTo(positionMs() + wholeMs);
+}
+
+void LoadReplayEngine::advanceTo(qint64 timeMs) {
+    timeMs = qMin(timeMs, endMs());
+    m_clock->setNowMs(timeMs);
+
+    const qint64 sampleCount = m_archive->sampleCount();
+    auto flush = [this]() {
+        if (m_widget && !m_batchTimes.isEmpty()) {
+            m_widget->appendSeriesSamples(m_seriesId, m_batchTimes.constData(), m_batchValues.constData(),
+                                          m_batchTimes.size());
+        }
+        m_batchTimes.resize(0);
+        m_batchValues.resize(0);
+    };
+    while (m_nextIndex < sampleCount && m_archive->timeAt(m_nextIndex) <= timeMs) {
+        m_batchTimes.append(m_archive->timeAt(m_nextIndex));
+        m_batchValues.append(m_archive->valueAt(m_nextIndex));
+        ++m_nextIndex;
+        if (m_batchTimes.size() >= kMaxBatch) flush();
+    }
+    flush();
+
+    // 没有新样本时曲线同样随虚拟时间滚动
+    if (m_widget) m_widget->update();
+    emit positionChanged(timeMs);
+
+    if (timeMs >= endMs() && m_timer.isActive()) {
+        pause();
+        emit finished();
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <QtGlobal>
+
+#include <memory>
+
+#include "LoadClock.h"
+
+class LoadSessionArchive;
+class LoadTimelineWidget;
+
+// 会话回放：按虚拟时钟把归档样本送入控件，控件的时间源同时切换为该虚拟时钟，
+// 图表即按录制时的实时效果显示。
+// 播放时虚拟时间按实际流逝时间 × 倍速（1x–1000x）推进；逐帧步进每次固定推进
+// 帧间隔 × 倍速，结果与运行环境无关，可用于事故复盘与可复现的绘制基准。
+class LoadReplayEngine : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+    Q_PROPERTY(bool playing READ isPlaying NOTIFY playingChanged)
+    Q_PROPERTY(int frameIntervalMs READ frameIntervalMs WRITE setFrameIntervalMs)
+
+public:
+    static constexpr double MinSpeed = 1.0;
+    static constexpr double MaxSpeed = 1000.0;
+
+    explicit LoadReplayEngine(QObject *parent = nullptr);
+    ~LoadReplayEngine() override;
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_archive != nullptr; }
+
+    // 回放目标：样本写入指定序列（默认主序列），控件改用回放虚拟时钟；切换目标时恢复原控件的时间源
+    void setTarget(LoadTimelineWidget *widget, int seriesId = 0);
+    LoadTimelineWidget *target() const { return m_widget; }
+
+    double speed() const { return m_speed; }
+    bool isPlaying() const { return m_timer.isActive(); }
+    int frameIntervalMs() const { return m_frameIntervalMs; }
+    void setFrameIntervalMs(int ms);
+
+    // 回放时间范围与当前位置（UTC 毫秒）
+    qint64 startMs() const;
+    qint64 endMs() const;
+    qint64 positionMs() const { return m_clock->nowMs(); }
+    std::shared_ptr<LoadVirtualClock> clock() const { return m_clock; }
+
+public slots:
+    void play();
+    void pause();
+    // 暂停并推进一帧
+    void stepFrame();
+    // 跳转：清空目标序列，重新送入该时刻之前一个时间窗口内的样本
+    void seek(qint64 timeMs);
+    void setSpeed(double speed);
+
+signals:
+    void speedChanged(double speed);
+    void playingChanged(bool playing);
+    void positionChanged(qint64 timeMs);
+    void finished();
+
+private:
+    void tick();
+    // 虚拟时间推进到 timeMs，并送入 (当前位置, timeMs] 内的样本
+    void advanceTo(qint64 timeMs);
+    void restoreTargetClock();
+
+    std::unique_ptr<LoadSessionArchive> m_archive;
+    QPointer<LoadTimelineWidget> m_widget;
+    int m_seriesId = 0;
+    std::shared_ptr<LoadClock> m_targetClock;
+    std::shared_ptr<LoadVirtualClock> m_clock;
+    qint64 m_nextIndex = 0;
+    double m_speed = 1.0;
+    int m_frameIntervalMs = 16;
+    QTimer m_timer;
+    QElapsedTimer m_wallClock;
+    // 倍速换算后不足 1 毫秒的虚拟时间，留到下一拍
+    double m_carryMs = 0.0;
+    QVector<qint64> m_batchTimes;
+    QVector<double> m_batchValues;
+};
@@ -0,0 +1,223 @@
+#include "LoadRetentionTiers.h"
+
+#include <cmath>
+
+namespace {
+// 向下对齐到间隔的整数倍，负时间戳同样向下取整
+qint64 alignDown(qint64 timeMs, qint64 intervalMs) {
+    qint64 aligned = timeMs - timeMs % intervalMs;
+    if (aligned > timeMs) aligned -= intervalMs;
+    return aligned;
+}
+} // namespace
+
+QVector<LoadRetentionTiers::Tier> LoadRetentionTiers::defaultTiers() {
+    return {{1000, 3600 * 1000}, {10000, 0}};
+}
+
+void LoadRetentionTiers::configure(const QVector<Tier> &tiers, qint64 rawHorizonMs, qint64 windowMs, qint64 maxBytes,
+                                   qint64 nowMs) {
+    // 保留已汇总的数据（从最旧到最新），配置完成后按年龄重新归入
+    QVector<Bucket> existing;
+    for (int t = m_levels.size() - 1; t >= 0; --t) {
+        for (qsizetype i = 0; i < m_levels.at(t).count; ++i) {
+            existing.append(bucketAt(t, i));
+        }
+    }
+
+    m_levels.clear();
+    if (tiers.isEmpty()) {
+        m_dwell = LoadZoneStatistics::Dwell();
+        ++m_revision;
+        return;
+    }
+
+    // 各层覆盖的年龄区间首尾相接；容量按区间长度 / 间隔计算，另留两个桶容纳未对齐的首尾
+    QVector<qsizetype> capacities;
+    qint64 previousAge = rawHorizonMs;
+    qint64 totalBytes = 0;
+    for (int t = 0; t < tiers.size(); ++t) {
+        Level level;
+        level.tier = tiers.at(t);
+        level.tier.intervalMs = qMax<qint64>(1, level.tier.intervalMs);
+        const bool last = t == tiers.size() - 1;
+        level.maxAgeMs = last ? windowMs : qMax(level.tier.horizonMs, previousAge + level.tier.intervalMs);
+        const qint64 span = qMax<qint64>(0, level.maxAgeMs - previousAge);
+        const qsizetype capacity = static_cast<qsizetype>((span + level.tier.intervalMs - 1) / level.tier.intervalMs) + 2;
+        capacities.append(capacity);
+        totalBytes += qint64(capacity) * qint64(sizeof(Bucket));
+        previousAge = level.maxAgeMs;
+        m_levels.append(level);
+    }
+    if (maxBytes > 0 && totalBytes > maxBytes) {
+        // 超出预算时各层按比例缩减：较早的数据提前下移或丢弃
+        const double factor = double(maxBytes) / double(totalBytes);
+        for (qsizetype &capacity : capacities) {
+            capacity = qMax<qsizetype>(2, static_cast<qsizetype>(std::floor(capacity * factor)));
+        }
+    }
+    for (int t = 0; t < m_levels.size(); ++t) {
+        m_levels[t].ring.resize(capacities.at(t));
+    }
+
+    m_dwell = LoadZoneStatistics::Dwell();
+    for (const Bucket &bucket : existing) {
+        for (int z = 0; z < LoadZoneStatistics::ZoneCount; ++z) {
+            m_dwell.zoneMs[z] += bucket.zoneMs[z];
+        }
+        // 按年龄选择层级；遍历自旧到新，各层依然按时间先后追加
+        int tier = 0;
+        while (tier + 1 < m_levels.size() && nowMs - bucket.endTime >= m_levels.at(tier).maxAgeMs) {
+            ++tier;
+        }
+        push(tier, bucket);
+    }
+    ++m_revision;
+}
+
+void LoadRetentionTiers::disable() {
+    m_levels.clear();
+    m_dwell = LoadZoneStatistics::Dwell();
+    ++m_revision;
+}
+
+void LoadRetentionTiers::reset() {
+    for (Level &level : m_levels) {
+        level.head = 0;
+        level.count = 0;
+    }
+    m_dwell = LoadZoneStatistics::Dwell();
+    ++m_revision;
+}
+
+bool LoadRetentionTiers::isEmpty() const {
+    for (const Level &level : m_levels) {
+        if (level.count > 0) return false;
+    }
+    return true;
+}
+
+qint64 LoadRetentionTiers::memoryBytes() const {
+    qint64 bytes = 0;
+    for (const Level &level : m_levels) {
+        bytes += qint64(level.ring.size()) * qint64(sizeof(Bucket));
+    }
+    return bytes;
+}
+
+const LoadRetentionTiers::Bucket &LoadRetentionTiers::bucketAt(int tier, qsizetype index) const {
+    const Level &level = m_levels.at(tier);
+    return level.ring.at((level.head + index) % level.ring.size());
+}
+
+qsizetype LoadRetentionTiers::lowerBound(int tier, qint64 timeMs) const {
+    qsizetype low = 0;
+    qsizetype high = m_levels.at(tier).count;
+    while (low < high) {
+        const qsizetype mid = low + (high - low) / 2;
+        if (bucketAt(tier, mid).endTime < timeMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+LoadRetentionTiers::Bucket &LoadRetentionTiers::bucketRef(Level &level, qsizetype index) {
+    return level.ring[(level.head + index) % level.ring.size()];
+}
+
+void LoadRetentionTiers::fold(qint64 timeMs, double value, qint64 dwellMs, int zone) {
+    if (m_levels.isEmpty()) return;
+    Bucket bucket;
+    bucket.startMs = timeMs;
+    bucket.endTime = timeMs;
+    bucket.minTime = timeMs;
+    bucket.minValue = value;
+    bucket.maxTime = timeMs;
+    bucket.maxValue = value;
+    bucket.sum = value;
+    bucket.count = 1;
+    bucket.zoneMs[zone] = qMax<qint64>(0, dwellMs);
+    m_dwell.zoneMs[zone] += bucket.zoneMs[zone];
+    push(0, bucket);
+}
+
+void LoadRetentionTiers::advance(qint64 nowMs, qint64 windowStartMs) {
+    for (int t = 0; t + 1 < m_levels.size(); ++t) {
+        const Level &level = m_levels.at(t);
+        while (level.count > 0 && nowMs - bucketAt(t, 0).endTime >= level.maxAgeMs) {
+            popOldest(t);
+        }
+    }
+    // 时间窗口之外的桶直接丢弃（自最粗的层级起，数据自旧到新）
+    for (int t = m_levels.size() - 1; t >= 0; --t) {
+        Level &level = m_levels[t];
+        while (level.count > 0 && bucketAt(t, 0).endTime < windowStartMs) {
+            dropBucket(bucketAt(t, 0));
+            level.head = (level.head + 1) % level.ring.size();
+            --level.count;
+            ++m_revision;
+        }
+    }
+}
+
+void LoadRetentionTiers::push(int tier, const Bucket &bucket) {
+    Level &level = m_levels[tier];
+    const qint64 start = alignDown(bucket.startMs, level.tier.intervalMs);
+    if (level.count > 0) {
+        Bucket &newest = bucketRef(level, level.count - 1);
+        // 乱序到达的数据并入最新桶，保持层内按时间先后排列
+        if (start <= newest.startMs) {
+            merge(newest, bucket);
+            if (tier > 0) ++m_revision;
+            return;
+        }
+    }
+    if (level.count == level.ring.size()) {
+        popOldest(tier);
+    }
+    Bucket &slot = bucketRef(level, level.count);
+    slot = bucket;
+    slot.startMs = start;
+    ++level.count;
+    ++m_revision;
+}
+
+void LoadRetentionTiers::popOldest(int tier) {
+    Level &level = m_levels[tier];
+    if (level.count == 0) return;
+    const Bucket oldest = bucketAt(tier, 0);
+    level.head = (level.head + 1) % level.ring.size();
+    --level.count;
+    ++m_revision;
+    if (tier + 1 < m_levels.size()) {
+        push(tier + 1, oldest);
+    } else {
+        dropBucket(oldest);
+    }
+}
+
+void LoadRetentionTiers::dropBucket(const Bucket &bucket) {
+    for (int z = 0; z < LoadZoneStatistics::ZoneCount; ++z) {
+        m_dwell.zoneMs[z] -= bucket.zoneMs[z];
+    }
+}
+
+void LoadRetentionTiers::merge(Bucket &into, const Bucket &from) {
+    if (from.minValue < into.minValue) {
+        into.minValue = from.minValue;
+        into.minTime = from.minTime;
+    }
+    if (from.maxValue > into.maxValue) {
+        into.maxValue = from.maxValue;
+        into.maxTime = from.maxTime;
+    }
+    into.endTime = qMax(into.endTime, from.endTime);
+    into.sum += from.sum;
+    into.count += from.count;
+    for (int z = 0; z < LoadZoneStatistics::ZoneCount; ++z) {
+        into.zoneMs[z] += from.zoneMs[z];
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "LoadZoneStatistics.h"
+
+// 分层保留：原始样本离开原始保留时长后折叠为定间隔汇总桶（最小/最大/均值/分区驻留），
+// 桶随年龄增长逐层下移到更粗的间隔（如 1 秒桶保留 1 小时，其后 10 秒桶保留到时间窗口起点）。
+// 每层为容量固定的环形存储，配置时一次性分配；某层写满时最旧的桶提前下移，最后一层写满时丢弃最旧的桶，
+// 因此内存占用在配置后不再增长。
+class LoadRetentionTiers {
+public:
+    // 汇总层级：intervalMs 为桶间隔，horizonMs 为数据留在本层的最大年龄（最后一层忽略，保留到时间窗口起点）
+    struct Tier {
+        qint64 intervalMs = 1000;
+        qint64 horizonMs = 0;
+    };
+
+    // 汇总桶：startMs 按本层间隔对齐；endTime 为桶内最新样本的时刻
+    struct Bucket {
+        qint64 startMs = 0;
+        qint64 endTime = 0;
+        qint64 minTime = 0;
+        double minValue = 0.0;
+        qint64 maxTime = 0;
+        double maxValue = 0.0;
+        double sum = 0.0;
+        qint64 count = 0;
+        qint64 zoneMs[LoadZoneStatistics::ZoneCount] = {0, 0, 0};
+
+        double mean() const { return count > 0 ? sum / count : 0.0; }
+    };
+
+    // 默认配置：1 秒桶保留 1 小时，其后 10 秒桶
+    static QVector<Tier> defaultTiers();
+
+    // 配置层级：rawHorizonMs 之前的数据进入汇总层，最后一层保留到 windowMs；
+    // maxBytes > 0 时按比例缩减各层容量使总占用不超过该值。已汇总的数据按年龄重新归入新的层级
+    void configure(const QVector<Tier> &tiers, qint64 rawHorizonMs, qint64 windowMs, qint64 maxBytes, qint64 nowMs);
+    // 停用并释放全部层级
+    void disable();
+    bool isEnabled() const { return !m_levels.isEmpty(); }
+    // 清空汇总数据，保留配置
+    void reset();
+
+    // 原始样本离开原始层时调用：dwellMs 为该样本与后继样本的间隔，计入 zone 分区的驻留时长
+    void fold(qint64 timeMs, double value, qint64 dwellMs, int zone);
+    // 把超出各层年龄的桶下移到下一层，并丢弃完全早于 windowStartMs 的桶
+    void advance(qint64 nowMs, qint64 windowStartMs);
+
+    int tierCount() const { return m_levels.size(); }
+    qsizetype bucketCount(int tier) const { return m_levels.at(tier).count; }
+    // 层内按时间先后访问，0 为最旧
+    const Bucket &bucketAt(int tier, qsizetype index) const;
+    // 二分查找层内第一个 endTime 不早于 timeMs 的桶下标，全部更早时返回 bucketCount(tier)
+    qsizetype lowerBound(int tier, qint64 timeMs) const;
+    bool isEmpty() const;
+
+    // 汇总数据的分区驻留时长合计（按汇总时的阈值计算）
+    const LoadZoneStatistics::Dwell &dwell() const { return m_dwell; }
+    // 各层环形存储占用的字节数
+    qint64 memoryBytes() const;
+    // 桶的增删与下移时递增（并入第 0 层最新桶不递增），用于判断缓存的汇总路径是否过期
+    quint64 revision() const { return m_revision; }
+
+private:
+    struct Level {
+        Tier tier;
+        // 数据留在本层的最大年龄；最后一层不使用
+        qint64 maxAgeMs = 0;
+        QVector<Bucket> ring;
+        qsizetype head = 0;
+        qsizetype count = 0;
+    };
+
+    Bucket &bucketRef(Level &level, qsizetype index);
+    // 并入本层最新桶（对齐起点相同或早于最新桶时），否则新建桶；本层写满时先下移最旧的桶
+    void push(int tier, const Bucket &bucket);
+    // 移出本层最旧的桶：下移到下一层，最后一层则丢弃
+    void popOldest(int tier);
+    void dropBucket(const Bucket &bucket);
+    static void merge(Bucket &into, const Bucket &from);
+
+    QVector<Level> m_levels;
+    LoadZoneStatistics::Dwell m_dwell;
+    quint64 m_revision = 0;
+};
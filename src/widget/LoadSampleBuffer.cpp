@@ -0,0 +1,110 @@
+#include "LoadSampleBuffer.h"
+
+namespace {
+qsizetype roundUpToPowerOfTwo(qsizetype value) {
+    qsizetype result = 16;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+} // namespace
+
+LoadSampleBuffer::LoadSampleBuffer(qsizetype initialCapacity) {
+    reserve(initialCapacity);
+}
+
+void LoadSampleBuffer::reserve(qsizetype capacity) {
+    const qsizetype newCapacity = roundUpToPowerOfTwo(capacity);
+    if (newCapacity <= m_times.size()) return;
+    relayout(newCapacity);
+}
+
+void LoadSampleBuffer::squeeze(qsizetype minimumCapacity) {
+    const qsizetype newCapacity = roundUpToPowerOfTwo(qMax(m_size, minimumCapacity));
+    if (newCapacity >= m_times.size()) return;
+    relayout(newCapacity);
+}
+
+void LoadSampleBuffer::relayout(qsizetype newCapacity) {
+    // 扩容或缩减时按逻辑顺序重新排布，头部回到物理下标 0
+    QVector<qint64> times(newCapacity);
+    QVector<double> values(newCapacity);
+    for (qsizetype i = 0; i < m_size; ++i) {
+        times[i] = timeAt(i);
+        values[i] = valueAt(i);
+    }
+    m_times.swap(times);
+    m_values.swap(values);
+    m_head = 0;
+    m_mask = newCapacity - 1;
+}
+
+void LoadSampleBuffer::clear() {
+    m_firstSequence += m_size;
+    m_head = 0;
+    m_size = 0;
+}
+
+void LoadSampleBuffer::append(qint64 timeMs, double value) {
+    if (m_size == m_times.size()) {
+        reserve(m_size * 2);
+    }
+    const qsizetype index = physicalIndex(m_size);
+    m_times.data()[index] = timeMs;
+    m_values.data()[index] = value;
+    ++m_size;
+}
+
+qsizetype LoadSampleBuffer::lowerBound(qint64 timeMs) const {
+    const qint64 *times = m_times.constData();
+    qsizetype low = 0;
+    qsizetype high = m_size;
+    while (low < high) {
+        const qsizetype mid = low + (high - low) / 2;
+        if (times[physicalIndex(mid)] < timeMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+qsizetype LoadSampleBuffer::countBefore(qint64 boundMs) const {
+    const qint64 *times = m_times.constData();
+    qsizetype count = 0;
+    while (count < m_size && times[physicalIndex(count)] < boundMs) {
+        ++count;
+    }
+    return count;
+}
+
+qsizetype LoadSampleBuffer::dropBefore(qint64 boundMs) {
+    const qsizetype dropped = countBefore(boundMs);
+    dropFront(dropped);
+    return dropped;
+}
+
+void LoadSampleBuffer::dropFront(qsizetype count) {
+    count = qMin(count, m_size);
+    if (count <= 0) return;
+    m_head = (m_head + count) & m_mask;
+    m_size -= count;
+    m_firstSequence += count;
+    if (m_size == 0) {
+        m_head = 0;
+    }
+}
+
+int LoadSampleBuffer::segments(qsizetype from, qsizetype count, Segment out[2]) const {
+    if (from < 0 || count <= 0 || from + count > m_size) return 0;
+
+    const qsizetype start = physicalIndex(from);
+    const qsizetype firstCount = qMin(count, m_times.size() - start);
+    out[0] = {m_times.constData() + start, m_values.constData() + start, firstCount};
+    if (firstCount == count) return 1;
+
+    out[1] = {m_times.constData(), m_values.constData(), count - firstCount};
+    return 2;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+// 负荷采样环形缓冲区：时间戳（UTC 毫秒）与负荷值按列分别连续存储。
+// 裁剪只需前移头指针；容量按 2 的幂增长，预热后追加不再分配内存。
+class LoadSampleBuffer {
+public:
+    // 连续存储段：环形存储最多被拆成两段
+    struct Segment {
+        const qint64 *times = nullptr;
+        const double *values = nullptr;
+        qsizetype count = 0;
+    };
+
+    explicit LoadSampleBuffer(qsizetype initialCapacity = 1024);
+
+    qsizetype size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    qsizetype capacity() const { return m_times.size(); }
+
+    void reserve(qsizetype capacity);
+    // 容量缩减到容纳现有样本（且不小于 minimumCapacity）的最小 2 的幂
+    void squeeze(qsizetype minimumCapacity = 16);
+    void clear();
+    void append(qint64 timeMs, double value);
+
+    // 按逻辑下标（0 为最旧样本）访问
+    qint64 timeAt(qsizetype index) const { return m_times.constData()[physicalIndex(index)]; }
+    double valueAt(qsizetype index) const { return m_values.constData()[physicalIndex(index)]; }
+    qint64 firstTime() const { return timeAt(0); }
+    qint64 lastTime() const { return timeAt(m_size - 1); }
+    double lastValue() const { return valueAt(m_size - 1); }
+
+    // 二分查找第一个时间戳不早于 timeMs 的逻辑下标，全部更早时返回 size()；要求样本按时间先后追加
+    qsizetype lowerBound(qint64 timeMs) const;
+    // 自头部起时间戳早于 boundMs 的连续样本数（遇到第一个不早于的即停止）
+    qsizetype countBefore(qint64 boundMs) const;
+    // 丢弃 countBefore(boundMs) 个样本，返回丢弃数量
+    qsizetype dropBefore(qint64 boundMs);
+    // 自头部起丢弃 count 个样本
+    void dropFront(qsizetype count);
+
+    // 缓冲区建立以来的累计序号：逻辑下标 0 对应的序号，随裁剪递增
+    qint64 firstSequence() const { return m_firstSequence; }
+
+    // 获取 [from, from + count) 范围的连续段，返回段数（0~2）
+    int segments(qsizetype from, qsizetype count, Segment out[2]) const;
+
+private:
+    void relayout(qsizetype newCapacity);
+    qsizetype physicalIndex(qsizetype index) const { return (m_head + index) & m_mask; }
+
+    QVector<qint64> m_times;
+    QVector<double> m_values;
+    qsizetype m_head = 0;
+    qsizetype m_size = 0;
+    qsizetype m_mask = 0;
+    qint64 m_firstSequence = 0;
+};
@@ -0,0 +1,74 @@
+#include "LoadSampleQueue.h"
+
+LoadSampleQueue::LoadSampleQueue(qsizetype capacity) {
+    quint64 size = 16;
+    while (size < static_cast<quint64>(qMax<qsizetype>(capacity, 1))) {
+        size <<= 1;
+    }
+    m_times.resize(size);
+    m_values.resize(size);
+    m_mask = size - 1;
+}
+
+bool LoadSampleQueue::push(qint64 timeMs, double value) {
+    const quint64 tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead > m_mask) {
+        // 缓存的读位置已过期时才重新读取，减少跨核同步
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if (tail - m_cachedHead > m_mask) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    const quint64 index = tail & m_mask;
+    m_times[index] = timeMs;
+    m_values[index] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    wakeConsumer();
+    return true;
+}
+
+qsizetype LoadSampleQueue::pushBatch(const qint64 *times, const double *values, qsizetype count) {
+    if (count <= 0) return 0;
+    const quint64 tail = m_tail.load(std::memory_order_relaxed);
+    quint64 space = m_mask + 1 - (tail - m_cachedHead);
+    if (space < static_cast<quint64>(count)) {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        space = m_mask + 1 - (tail - m_cachedHead);
+    }
+    const quint64 written = qMin<quint64>(space, static_cast<quint64>(count));
+    for (quint64 i = 0; i < written; ++i) {
+        const quint64 index = (tail + i) & m_mask;
+        m_times[index] = times[i];
+        m_values[index] = values[i];
+    }
+    // 整批只发布一次写位置
+    m_tail.store(tail + written, std::memory_order_release);
+    if (written > 0) wakeConsumer();
+    return static_cast<qsizetype>(written);
+}
+
+qsizetype LoadSampleQueue::size() const {
+    // 先读读位置再读写位置，保证差值非负
+    const quint64 head = m_head.load(std::memory_order_acquire);
+    const quint64 tail = m_tail.load(std::memory_order_acquire);
+    return static_cast<qsizetype>(tail - head);
+}
+
+bool LoadSampleQueue::park() {
+    m_parked.store(true, std::memory_order_relaxed);
+    // 与 wakeConsumer 中的栅栏配对：挂起标志与写位置至少有一方被对方看到，不会漏掉唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_tail.load(std::memory_order_relaxed) == m_head.load(std::memory_order_relaxed)) return true;
+    // 挂起期间已有写入：撤销挂起（生产者若已抢先撤销，唤醒回调已发出，多一次唤醒无害）
+    m_parked.store(false, std::memory_order_relaxed);
+    return false;
+}
+
+void LoadSampleQueue::wakeConsumer() {
+    if (!m_wakeHandler) return;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_parked.load(std::memory_order_relaxed) && m_parked.exchange(false, std::memory_order_relaxed)) {
+        m_wakeHandler();
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// 无锁单生产者/单消费者样本队列：生产线程写入，GUI 线程批量取出。
+// 容量固定（2 的幂），写满时丢弃新样本并计数，入队与出队均为无等待操作。
+// 消费者发现队列为空时可将其挂起：挂起后首次写入调用唤醒回调，消费者不必轮询空队列。
+class LoadSampleQueue {
+public:
+    explicit LoadSampleQueue(qsizetype capacity);
+
+    LoadSampleQueue(const LoadSampleQueue &) = delete;
+    LoadSampleQueue &operator=(const LoadSampleQueue &) = delete;
+
+    // 生产者线程调用；队列已满时返回 false 并累计丢弃数
+    bool push(qint64 timeMs, double value);
+    // 生产者线程调用：按剩余空间写入前若干个样本并一次发布，返回写入数量。
+    // 未写入的部分不计入丢弃数，由调用方等待后重试（背压）
+    qsizetype pushBatch(const qint64 *times, const double *values, qsizetype count);
+
+    // 消费者线程调用：最多取出 maxCount 个样本，返回实际数量
+    template <typename Consumer>
+    qsizetype drain(Consumer &&consumer, qsizetype maxCount = -1);
+
+    // 唤醒回调在生产者线程中调用，须在交给生产者之前设置
+    void setWakeHandler(std::function<void()> handler) { m_wakeHandler = std::move(handler); }
+    // 消费者线程调用：队列为空时挂起并返回 true，此后的首次写入触发唤醒回调；
+    // 队列非空（包括挂起过程中恰好写入）时返回 false，保持活动
+    bool park();
+
+    qsizetype capacity() const { return static_cast<qsizetype>(m_mask + 1); }
+    // 当前排队数量（近似值，可在任意线程读取）
+    qsizetype size() const;
+    quint64 droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    // 写位置发布后检查挂起标志，必要时唤醒消费者
+    void wakeConsumer();
+
+    std::vector<qint64> m_times;
+    std::vector<double> m_values;
+    quint64 m_mask = 0;
+
+    // 读写位置分处不同缓存行，避免伪共享
+    alignas(64) std::atomic<quint64> m_head{0};
+    alignas(64) std::atomic<quint64> m_tail{0};
+    quint64 m_cachedHead = 0;
+    alignas(64) std::atomic<quint64> m_dropped{0};
+    std::atomic<bool> m_parked{false};
+    std::function<void()> m_wakeHandler;
+};
+
+template <typename Consumer>
+qsizetype LoadSampleQueue::drain(Consumer &&consumer, qsizetype maxCount) {
+    const quint64 head = m_head.load(std::memory_order_relaxed);
+    const quint64 tail = m_tail.load(std::memory_order_acquire);
+    quint64 available = tail - head;
+    if (maxCount >= 0) {
+        available = qMin<quint64>(available, static_cast<quint64>(maxCount));
+    }
+    for (quint64 i = 0; i < available; ++i) {
+        const quint64 index = (head + i) & m_mask;
+        consumer(m_times[index], m_values[index]);
+    }
+    m_head.store(head + available, std::memory_order_release);
+    return static_cast<qsizetype>(available);
+}
+
+// 线程安全的样本生产者句柄：每个句柄独占一个单生产者队列，
+// 同一句柄同一时刻只应由一个线程写入；多个采集线程各自创建句柄即可。
+class LoadSampleProducer {
+public:
+    LoadSampleProducer() = default;
+    explicit LoadSampleProducer(std::shared_ptr<LoadSampleQueue> queue)
+        : m_queue(std::move(queue)) {}
+
+    bool isValid() const { return m_queue != nullptr; }
+    bool push(qint64 timeMs, double value) { return m_queue && m_queue->push(timeMs, value); }
+    qsizetype pushBatch(const qint64 *times, const double *values, qsizetype count) {
+        return m_queue ? m_queue->pushBatch(times, values, count) : 0;
+    }
+    qsizetype queuedCount() const { return m_queue ? m_queue->size() : 0; }
+    quint64 droppedCount() const { return m_queue ? m_queue->droppedCount() : 0; }
+
+private:
+    std::shared_ptr<LoadSampleQueue> m_queue;
+};
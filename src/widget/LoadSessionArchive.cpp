@@ -0,0 +1,330 @@
+#include "LoadSessionArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace LoadSessionFormat;
+
+LoadSessionWriter::~LoadSessionWriter() {
+    close();
+}
+
+bool LoadSessionWriter::open(const QString &path) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) return false;
+
+    m_sampleCount = 0;
+    m_lastTime = 0;
+    m_chunkIndex = 0;
+    m_times.reserve(ChunkCapacity);
+    m_values.reserve(ChunkCapacity);
+
+    FileHeader fileHeader;
+    if (m_file.size() == 0) {
+        // 新建：预留文件头空间
+        if (!m_file.resize(HeaderBytes) || !m_file.seek(0)
+            || m_file.write(reinterpret_cast<const char *>(&fileHeader), sizeof(fileHeader)) != sizeof(fileHeader)) {
+            m_file.close();
+            return false;
+        }
+        startChunk();
+        return true;
+    }
+
+    // 续写：校验文件头，未写满的最后一个数据块载入内存继续追加
+    if (m_file.read(reinterpret_cast<char *>(&fileHeader), sizeof(fileHeader)) != sizeof(fileHeader)
+        || fileHeader.magic != Magic || fileHeader.version != Version
+        || fileHeader.chunkCapacity != ChunkCapacity || fileHeader.blockSize != BlockSize
+        || fileHeader.chunkCount < 0 || m_file.size() < chunkOffset(fileHeader.chunkCount)) {
+        m_file.close();
+        return false;
+    }
+
+    m_sampleCount = fileHeader.sampleCount;
+    m_chunkIndex = fileHeader.chunkCount;
+    startChunk();
+    if (fileHeader.chunkCount == 0) return true;
+
+    const qint64 lastChunk = fileHeader.chunkCount - 1;
+    ChunkHeader header;
+    if (!m_file.seek(chunkOffset(lastChunk))
+        || m_file.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header)
+        || header.count <= 0 || header.count > ChunkCapacity) {
+        m_file.close();
+        return false;
+    }
+    m_lastTime = header.maxTime;
+    if (header.count == ChunkCapacity) return true;
+
+    m_times.resize(header.count);
+    m_values.resize(header.count);
+    const qint64 base = chunkOffset(lastChunk) + ChunkHeaderBytes;
+    const qint64 timeBytes = header.count * qint64(sizeof(qint64));
+    const qint64 valueBytes = header.count * qint64(sizeof(double));
+    if (!m_file.seek(base) || m_file.read(reinterpret_cast<char *>(m_times.data()), timeBytes) != timeBytes
+        || !m_file.seek(base + ChunkCapacity * qint64(sizeof(qint64)))
+        || m_file.read(reinterpret_cast<char *>(m_values.data()), valueBytes) != valueBytes) {
+        m_file.close();
+        return false;
+    }
+    m_chunkIndex = lastChunk;
+    m_chunkHeader = header;
+    m_flushedCount = header.count;
+    return true;
+}
+
+void LoadSessionWriter::close() {
+    if (!m_file.isOpen()) return;
+    flush();
+    m_file.close();
+}
+
+bool LoadSessionWriter::append(qint64 timeMs, double value) {
+    if (!m_file.isOpen()) return false;
+    if (m_sampleCount > 0 && timeMs < m_lastTime) return false;
+
+    const qint64 index = m_times.size();
+    const qint64 block = index / BlockSize;
+    m_times.append(timeMs);
+    m_values.append(value);
+
+    ChunkHeader &header = m_chunkHeader;
+    if (index == 0) {
+        header.minTime = timeMs;
+        header.minValue = value;
+        header.maxValue = value;
+    } else {
+        header.minValue = qMin(header.minValue, value);
+        header.maxValue = qMax(header.maxValue, value);
+    }
+    header.maxTime = timeMs;
+    header.count = index + 1;
+
+    if (index % BlockSize == 0) {
+        header.blockMin[block] = value;
+        header.blockMax[block] = value;
+        header.blockMinTime[block] = timeMs;
+    } else {
+        header.blockMin[block] = qMin(header.blockMin[block], value);
+        header.blockMax[block] = qMax(header.blockMax[block], value);
+    }
+    header.blockMaxTime[block] = timeMs;
+
+    ++m_sampleCount;
+    m_lastTime = timeMs;
+
+    if (header.count == ChunkCapacity) {
+        if (!writeChunkRange(m_flushedCount, header.count)) return false;
+        ++m_chunkIndex;
+        startChunk();
+    }
+    return true;
+}
+
+bool LoadSessionWriter::flush() {
+    if (!m_file.isOpen()) return false;
+    if (m_chunkHeader.count > m_flushedCount && !writeChunkRange(m_flushedCount, m_chunkHeader.count)) {
+        return false;
+    }
+    return m_file.flush();
+}
+
+bool LoadSessionWriter::writeChunkRange(qint64 from, qint64 to) {
+    const qint64 offset = chunkOffset(m_chunkIndex);
+    // 数据块按定长预留，列数据写入各自的固定偏移
+    if (m_file.size() < offset + ChunkBytes && !m_file.resize(offset + ChunkBytes)) return false;
+
+    const qint64 timeBytes = (to - from) * qint64(sizeof(qint64));
+    const qint64 valueBytes = (to - from) * qint64(sizeof(double));
+    const qint64 timesOffset = offset + ChunkHeaderBytes + from * qint64(sizeof(qint64));
+    const qint64 valuesOffset = offset + ChunkHeaderBytes + ChunkCapacity * qint64(sizeof(qint64))
+        + from * qint64(sizeof(double));
+    if (!m_file.seek(timesOffset)
+        || m_file.write(reinterpret_cast<const char *>(m_times.constData() + from), timeBytes) != timeBytes
+        || !m_file.seek(valuesOffset)
+        || m_file.write(reinterpret_cast<const char *>(m_values.constData() + from), valueBytes) != valueBytes) {
+        return false;
+    }
+
+    // 先写列数据再更新块头与文件头，中途中断时读取端只会看到旧的样本数
+    if (!m_file.seek(offset)
+        || m_file.write(reinterpret_cast<const char *>(&m_chunkHeader), sizeof(m_chunkHeader)) != sizeof(m_chunkHeader)) {
+        return false;
+    }
+
+    FileHeader fileHeader;
+    fileHeader.chunkCount = m_chunkIndex + 1;
+    fileHeader.sampleCount = m_sampleCount;
+    if (!m_file.seek(0)
+        || m_file.write(reinterpret_cast<const char *>(&fileHeader), sizeof(fileHeader)) != sizeof(fileHeader)) {
+        return false;
+    }
+
+    m_flushedCount = to;
+    return true;
+}
+
+void LoadSessionWriter::startChunk() {
+    m_times.clear();
+    m_values.clear();
+    m_chunkHeader = ChunkHeader();
+    m_flushedCount = 0;
+}
+
+LoadSessionArchive::~LoadSessionArchive() {
+    close();
+}
+
+bool LoadSessionArchive::open(const QString &path) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+
+    m_size = m_file.size();
+    if (m_size < HeaderBytes) {
+        close();
+        return false;
+    }
+    // 整文件映射只占用地址空间，实际页面在访问时才载入
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        close();
+        return false;
+    }
+
+    FileHeader fileHeader;
+    std::memcpy(&fileHeader, m_data, sizeof(fileHeader));
+    if (fileHeader.magic != Magic || fileHeader.version != Version
+        || fileHeader.chunkCapacity != ChunkCapacity || fileHeader.blockSize != BlockSize) {
+        close();
+        return false;
+    }
+
+    // 只读取块头建立索引；块数来自文件，按文件实际长度限制预留
+    const qint64 chunkLimit = (m_size - HeaderBytes) / ChunkBytes;
+    m_chunks.reserve(static_cast<qsizetype>(qBound<qint64>(0, fileHeader.chunkCount, chunkLimit)));
+    for (qint64 chunk = 0; chunk < fileHeader.chunkCount; ++chunk) {
+        if (chunkOffset(chunk) + ChunkBytes > m_size) break;
+        const ChunkHeader *header = chunkHeader(chunk);
+        if (header->count <= 0 || header->count > ChunkCapacity) break;
+
+        ChunkInfo info;
+        info.firstIndex = m_sampleCount;
+        info.count = header->count;
+        info.minTime = header->minTime;
+        info.maxTime = header->maxTime;
+        info.minValue = header->minValue;
+        info.maxValue = header->maxValue;
+        m_chunks.append(info);
+        m_sampleCount += header->count;
+
+        // 仅最后一个数据块允许未写满
+        if (header->count < ChunkCapacity) break;
+    }
+    return true;
+}
+
+void LoadSessionArchive::close() {
+    if (m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+    m_file.close();
+    m_size = 0;
+    m_sampleCount = 0;
+    m_chunks.clear();
+}
+
+qint64 LoadSessionArchive::timeAt(qint64 index) const {
+    return chunkTimes(index / ChunkCapacity)[index % ChunkCapacity];
+}
+
+double LoadSessionArchive::valueAt(qint64 index) const {
+    return chunkValues(index / ChunkCapacity)[index % ChunkCapacity];
+}
+
+qint64 LoadSessionArchive::lowerBound(qint64 timeMs) const {
+    auto it = std::lower_bound(m_chunks.cbegin(), m_chunks.cend(), timeMs,
+                               [](const ChunkInfo &info, qint64 time) { return info.maxTime < time; });
+    if (it == m_chunks.cend()) return m_sampleCount;
+
+    const qsizetype chunk = it - m_chunks.cbegin();
+    const qint64 *times = chunkTimes(chunk);
+    return it->firstIndex + (std::lower_bound(times, times + it->count, timeMs) - times);
+}
+
+void LoadSessionArchive::envelope(qint64 startMs, qint64 endMs, int columns,
+                                  QVector<double> &minValues, QVector<double> &maxValues) const {
+    const double inf = std::numeric_limits<double>::infinity();
+    minValues.fill(inf, qMax(0, columns));
+    maxValues.fill(-inf, qMax(0, columns));
+
+    if (isOpen() && columns > 0 && endMs > startMs) {
+        const double columnMs = double(endMs - startMs) / columns;
+        auto columnOf = [&](qint64 timeMs) {
+            return qBound(0, static_cast<int>((timeMs - startMs) / columnMs), columns - 1);
+        };
+        auto merge = [&](int column, double low, double high) {
+            minValues[column] = qMin(minValues[column], low);
+            maxValues[column] = qMax(maxValues[column], high);
+        };
+
+        for (qsizetype chunk = 0; chunk < m_chunks.size(); ++chunk) {
+            const ChunkInfo &info = m_chunks.at(chunk);
+            if (info.maxTime < startMs || info.minTime >= endMs) continue;
+
+            // 整块跨度不超过一列：直接使用块极值
+            if (info.minTime >= startMs && info.maxTime < endMs && info.maxTime - info.minTime <= columnMs) {
+                merge(columnOf(info.minTime), info.minValue, info.maxValue);
+                merge(columnOf(info.maxTime), info.minValue, info.maxValue);
+                continue;
+            }
+
+            // 分段的取舍只读块头；只有跨度大于一列或跨过窗口边界的分段才访问时间戳与负荷值列
+            const ChunkHeader *header = chunkHeader(chunk);
+            for (qint64 block = 0; block * BlockSize < info.count; ++block) {
+                const qint64 first = header->blockMinTime[block];
+                const qint64 last = header->blockMaxTime[block];
+                if (last < startMs || first >= endMs) continue;
+
+                if (first >= startMs && last < endMs && last - first <= columnMs) {
+                    merge(columnOf(first), header->blockMin[block], header->blockMax[block]);
+                    merge(columnOf(last), header->blockMin[block], header->blockMax[block]);
+                    continue;
+                }
+
+                const qint64 *times = chunkTimes(chunk);
+                const double *values = chunkValues(chunk);
+                const qint64 from = block * BlockSize;
+                const qint64 to = qMin(info.count, from + BlockSize);
+                for (qint64 i = from; i < to; ++i) {
+                    if (times[i] < startMs || times[i] >= endMs) continue;
+                    merge(columnOf(times[i]), values[i], values[i]);
+                }
+            }
+        }
+    }
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (qsizetype i = 0; i < minValues.size(); ++i) {
+        if (minValues[i] > maxValues[i]) {
+            minValues[i] = nan;
+            maxValues[i] = nan;
+        }
+    }
+}
+
+const ChunkHeader *LoadSessionArchive::chunkHeader(qsizetype chunk) const {
+    return reinterpret_cast<const ChunkHeader *>(m_data + chunkOffset(chunk));
+}
+
+const qint64 *LoadSessionArchive::chunkTimes(qsizetype chunk) const {
+    return reinterpret_cast<const qint64 *>(m_data + chunkOffset(chunk) + ChunkHeaderBytes);
+}
+
+const double *LoadSessionArchive::chunkValues(qsizetype chunk) const {
+    return reinterpret_cast<const double *>(m_data + chunkOffset(chunk) + ChunkHeaderBytes
+                                            + ChunkCapacity * qint64(sizeof(qint64)));
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// 会话归档文件格式（本机字节序、只追加的列式存储）：
+//   [文件头 4 KiB][数据块 0][数据块 1]...
+// 每个数据块定长：块头 4 KiB（样本数、时间/负荷范围、每 1024 个样本的分段时间范围与极值）
+// + 时间戳列（int64 UTC 毫秒 × 65536）+ 负荷值列（double × 65536）。
+// 块定长使任意样本的偏移可直接计算，打开归档时只需读取各块块头。
+namespace LoadSessionFormat {
+constexpr quint32 Magic = 0x41534c4d; // "MLSA"
+constexpr quint32 Version = 2;
+constexpr qint64 HeaderBytes = 4096;
+constexpr qint64 ChunkCapacity = 65536;
+constexpr qint64 BlockSize = 1024;
+constexpr qint64 BlocksPerChunk = ChunkCapacity / BlockSize;
+constexpr qint64 ChunkHeaderBytes = 4096;
+constexpr qint64 ChunkBytes = ChunkHeaderBytes + ChunkCapacity * qint64(sizeof(qint64) + sizeof(double));
+
+struct FileHeader {
+    quint32 magic = Magic;
+    quint32 version = Version;
+    quint32 chunkCapacity = ChunkCapacity;
+    quint32 blockSize = BlockSize;
+    qint64 chunkCount = 0;
+    qint64 sampleCount = 0;
+};
+
+struct ChunkHeader {
+    qint64 count = 0;
+    qint64 minTime = 0;
+    qint64 maxTime = 0;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    double blockMin[BlocksPerChunk] = {};
+    double blockMax[BlocksPerChunk] = {};
+    // 分段首尾时间戳：按列取分段极值时只读块头，不访问时间戳列
+    qint64 blockMinTime[BlocksPerChunk] = {};
+    qint64 blockMaxTime[BlocksPerChunk] = {};
+};
+
+static_assert(sizeof(FileHeader) <= HeaderBytes, "file header exceeds reserved space");
+static_assert(sizeof(ChunkHeader) <= ChunkHeaderBytes, "chunk header exceeds reserved space");
+
+inline qint64 chunkOffset(qint64 chunk) { return HeaderBytes + chunk * ChunkBytes; }
+} // namespace LoadSessionFormat
+
+// 会话归档写入器：在内存中累积当前数据块，写满或 flush() 时追加到文件。
+// 每次只写出上次写出之后的新样本与块头，定期调用 flush() 时单次写入量与写出间隔内的样本数成正比；
+// 未写出的样本在进程异常退出时丢失。已写满的数据块不再改写；时间戳须非递减。
+class LoadSessionWriter {
+public:
+    LoadSessionWriter() = default;
+    ~LoadSessionWriter();
+
+    LoadSessionWriter(const LoadSessionWriter &) = delete;
+    LoadSessionWriter &operator=(const LoadSessionWriter &) = delete;
+
+    // 新建或续写归档
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    // 时间戳早于上一个样本时拒绝写入并返回 false
+    bool append(qint64 timeMs, double value);
+    bool flush();
+
+    qint64 sampleCount() const { return m_sampleCount; }
+    QString errorString() const { return m_file.errorString(); }
+
+private:
+    bool writeChunkRange(qint64 from, qint64 to);
+    void startChunk();
+
+    QFile m_file;
+    QVector<qint64> m_times;
+    QVector<double> m_values;
+    LoadSessionFormat::ChunkHeader m_chunkHeader;
+    qint64 m_chunkIndex = 0;
+    qint64 m_flushedCount = 0;
+    qint64 m_sampleCount = 0;
+    qint64 m_lastTime = 0;
+};
+
+// 会话归档读取器：整文件内存映射，按需访问的页面才会被载入。
+class LoadSessionArchive {
+public:
+    // 块索引：打开时从各块块头读取
+    struct ChunkInfo {
+        qint64 firstIndex = 0;
+        qint64 count = 0;
+        qint64 minTime = 0;
+        qint64 maxTime = 0;
+        double minValue = 0.0;
+        double maxValue = 0.0;
+    };
+
+    LoadSessionArchive() = default;
+    ~LoadSessionArchive();
+
+    LoadSessionArchive(const LoadSessionArchive &) = delete;
+    LoadSessionArchive &operator=(const LoadSessionArchive &) = delete;
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    QString fileName() const { return m_file.fileName(); }
+
+    qint64 sampleCount() const { return m_sampleCount; }
+    qint64 startTime() const { return m_chunks.isEmpty() ? 0 : m_chunks.constFirst().minTime; }
+    qint64 endTime() const { return m_chunks.isEmpty() ? 0 : m_chunks.constLast().maxTime; }
+    const QVector<ChunkInfo> &chunks() const { return m_chunks; }
+
+    qint64 timeAt(qint64 index) const;
+    double valueAt(qint64 index) const;
+    // 第一个时间戳不早于 timeMs 的样本下标
+    qint64 lowerBound(qint64 timeMs) const;
+
+    // 计算 [startMs, endMs) 内每列的最小/最大值，无数据的列为 NaN。
+    // 优先使用块与分段极值（只读块头），只有跨度大于一列或跨过窗口边界的分段才访问原始样本。
+    void envelope(qint64 startMs, qint64 endMs, int columns,
+                  QVector<double> &minValues, QVector<double> &maxValues) const;
+
+private:
+    const LoadSessionFormat::ChunkHeader *chunkHeader(qsizetype chunk) const;
+    const qint64 *chunkTimes(qsizetype chunk) const;
+    const double *chunkValues(qsizetype chunk) const;
+
+    QFile m_file;
+    uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    qint64 m_sampleCount = 0;
+    QVector<ChunkInfo> m_chunks;
+};
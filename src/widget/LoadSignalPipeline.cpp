@@ -0,0 +1,192 @@
+#include "LoadSignalPipeline.h"
+
+#include <QtNumeric>
+
+#include <algorithm>
+#include <cmath>
+
+void LoadSignalPipeline::addEma(double timeConstantMs) {
+    Stage stage;
+    stage.kind = EmaStage;
+    stage.timeConstantMs = qMax(0.0, timeConstantMs);
+    m_stages.push_back(std::move(stage));
+}
+
+void LoadSignalPipeline::addMedian(int windowSamples) {
+    Stage stage;
+    stage.kind = MedianStage;
+    const size_t size = static_cast<size_t>(qMax(1, windowSamples));
+    stage.window.assign(size, 0.0);
+    // 预留满窗口容量，之后插入与删除只移动元素
+    stage.sorted.reserve(size);
+    m_stages.push_back(std::move(stage));
+}
+
+void LoadSignalPipeline::addDownsample(qint64 periodMs) {
+    Stage stage;
+    stage.kind = DownsampleStage;
+    stage.periodMs = qMax<qint64>(1, periodMs);
+    m_stages.push_back(std::move(stage));
+}
+
+void LoadSignalPipeline::addOutlierRejection(double sigmas, int warmupSamples) {
+    Stage stage;
+    stage.kind = OutlierStage;
+    stage.sigmas = qMax(0.0, sigmas);
+    stage.warmupSamples = qMax(2, warmupSamples);
+    m_stages.push_back(std::move(stage));
+}
+
+void LoadSignalPipeline::clear() {
+    m_stages.clear();
+    m_inputCount = 0;
+    m_outputCount = 0;
+    m_rejectedCount = 0;
+}
+
+void LoadSignalPipeline::reset() {
+    for (Stage &stage : m_stages) {
+        resetStage(stage);
+    }
+}
+
+void LoadSignalPipeline::resetStage(Stage &stage) {
+    stage.primed = false;
+    stage.lastTimeMs = 0;
+    stage.mean = 0.0;
+    stage.variance = 0.0;
+    stage.seen = 0;
+    stage.sorted.clear();
+    stage.windowHead = 0;
+    stage.windowCount = 0;
+    stage.bucket = 0;
+    stage.timeOffsetSum = 0;
+    stage.valueSum = 0.0;
+    stage.bucketCount = 0;
+}
+
+bool LoadSignalPipeline::process(qint64 &timeMs, double &value) {
+    ++m_inputCount;
+    if (!qIsFinite(value)) {
+        ++m_rejectedCount;
+        return false;
+    }
+    for (Stage &stage : m_stages) {
+        bool emitted = false;
+        switch (stage.kind) {
+        case EmaStage:
+            emitted = feedEma(stage, timeMs, value);
+            break;
+        case MedianStage:
+            emitted = feedMedian(stage, timeMs, value);
+            break;
+        case DownsampleStage:
+            emitted = feedDownsample(stage, timeMs, value);
+            break;
+        case OutlierStage:
+            emitted = feedOutlier(stage, timeMs, value);
+            break;
+        }
+        if (!emitted) return false;
+    }
+    ++m_outputCount;
+    return true;
+}
+
+bool LoadSignalPipeline::feedEma(Stage &stage, qint64 &timeMs, double &value) {
+    if (!stage.primed || stage.timeConstantMs <= 0) {
+        stage.primed = true;
+        stage.mean = value;
+    } else {
+        // 权重随时间间隔变化：间隔越长，新样本占比越大
+        const double dt = double(qMax<qint64>(0, timeMs - stage.lastTimeMs));
+        const double alpha = 1.0 - std::exp(-dt / stage.timeConstantMs);
+        stage.mean += alpha * (value - stage.mean);
+    }
+    stage.lastTimeMs = timeMs;
+    value = stage.mean;
+    return true;
+}
+
+bool LoadSignalPipeline::feedMedian(Stage &stage, qint64 &timeMs, double &value) {
+    Q_UNUSED(timeMs);
+    std::vector<double> &window = stage.window;
+    std::vector<double> &sorted = stage.sorted;
+    const qsizetype size = static_cast<qsizetype>(window.size());
+    if (stage.windowCount < size) {
+        window[static_cast<size_t>((stage.windowHead + stage.windowCount) % size)] = value;
+        ++stage.windowCount;
+    } else {
+        // 窗口已满：有序数组中移除最早的样本
+        double &oldest = window[static_cast<size_t>(stage.windowHead)];
+        sorted.erase(std::lower_bound(sorted.begin(), sorted.end(), oldest));
+        oldest = value;
+        stage.windowHead = (stage.windowHead + 1) % size;
+    }
+    sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), value), value);
+
+    const size_t count = sorted.size();
+    value = (count % 2 == 1) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    return true;
+}
+
+bool LoadSignalPipeline::feedDownsample(Stage &stage, qint64 &timeMs, double &value) {
+    // 向下取整的周期编号，负时间戳同样按周期对齐
+    qint64 bucket = timeMs / stage.periodMs;
+    if (timeMs % stage.periodMs < 0) --bucket;
+
+    bool emitted = false;
+    qint64 outTime = 0;
+    double outValue = 0.0;
+    if (stage.bucketCount > 0 && bucket > stage.bucket) {
+        // 输出上一周期的平均值，时间取周期内样本的平均时刻
+        outTime = stage.bucket * stage.periodMs + stage.timeOffsetSum / stage.bucketCount;
+        outValue = stage.valueSum / stage.bucketCount;
+        emitted = true;
+        stage.bucketCount = 0;
+    }
+    if (stage.bucketCount == 0) {
+        stage.bucket = bucket;
+        stage.timeOffsetSum = 0;
+        stage.valueSum = 0.0;
+    }
+    // 乱序样本并入当前周期
+    stage.timeOffsetSum += qMax<qint64>(0, timeMs - stage.bucket * stage.periodMs);
+    stage.valueSum += value;
+    ++stage.bucketCount;
+
+    if (emitted) {
+        timeMs = outTime;
+        value = outValue;
+    }
+    return emitted;
+}
+
+bool LoadSignalPipeline::feedOutlier(Stage &stage, qint64 &timeMs, double &value) {
+    Q_UNUSED(timeMs);
+    if (stage.seen < stage.warmupSamples) {
+        // 预热：累积均值与方差，样本全部通过
+        ++stage.seen;
+        const double delta = value - stage.mean;
+        stage.mean += delta / stage.seen;
+        stage.variance += (delta * (value - stage.mean) - stage.variance) / stage.seen;
+        return true;
+    }
+
+    const double sigma = std::sqrt(stage.variance);
+    const double deviation = value - stage.mean;
+    const double bound = stage.sigmas * sigma;
+    const bool rejected = sigma > 0 && std::abs(deviation) > bound;
+    // 指数加权更新，有效长度与预热样本数一致；被剔除的样本按截断值更新
+    const double alpha = 2.0 / (stage.warmupSamples + 1);
+    const double diff = rejected ? std::copysign(bound, deviation) : deviation;
+    const double increment = alpha * diff;
+    stage.mean += increment;
+    stage.variance = (1.0 - alpha) * (stage.variance + diff * increment);
+
+    if (rejected) {
+        ++m_rejectedCount;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <vector>
+
+// 接入信号调理：样本写入存储之前依次经过的流式处理级，按添加顺序串联。
+// 每级每个输入至多产生一个输出，状态在配置时一次性分配，处理样本时不再分配内存。
+// 非有限值（NaN/无穷）无法参与平均，不进入任何处理级，直接丢弃并计入剔除数。
+// 值类型，可复制；副本各自持有状态。
+class LoadSignalPipeline {
+public:
+    enum StageKind {
+        // 指数滑动平均：按相邻样本时间间隔与时间常数计算权重，采样不均匀时同样适用
+        EmaStage = 0,
+        // 滑动中值：最近 N 个样本的中值，去除脉冲噪声
+        MedianStage = 1,
+        // 定周期降采样：同一周期内的样本取平均，周期结束（下一周期首个样本到达）时输出
+        DownsampleStage = 2,
+        // 离群值剔除：预热后偏离指数加权均值超过 k 倍标准差的样本丢弃；
+        // 被丢弃的样本按截断到边界的值更新统计量，真实的阶跃变化会在若干样本后被接受
+        OutlierStage = 3
+    };
+
+    void addEma(double timeConstantMs);
+    void addMedian(int windowSamples);
+    void addDownsample(qint64 periodMs);
+    void addOutlierRejection(double sigmas, int warmupSamples = 16);
+    void clear();
+
+    bool isEmpty() const { return m_stages.empty(); }
+    int stageCount() const { return static_cast<int>(m_stages.size()); }
+    StageKind stageKind(int index) const { return m_stages[static_cast<size_t>(index)].kind; }
+
+    // 清空各级状态（配置不变），整体替换数据前调用
+    void reset();
+
+    // 处理一个样本：返回 true 时 timeMs/value 为输出样本，返回 false 表示本次无输出
+    bool process(qint64 &timeMs, double &value);
+
+    // 输入样本数、输出样本数与被剔除的样本数（离群值与非有限值）
+    quint64 inputCount() const { return m_inputCount; }
+    quint64 outputCount() const { return m_outputCount; }
+    quint64 rejectedCount() const { return m_rejectedCount; }
+
+private:
+    struct Stage {
+        StageKind kind = EmaStage;
+        // 配置
+        double timeConstantMs = 0.0;
+        qint64 periodMs = 0;
+        double sigmas = 0.0;
+        int warmupSamples = 0;
+        // EMA / 离群值统计状态
+        bool primed = false;
+        qint64 lastTimeMs = 0;
+        double mean = 0.0;
+        double variance = 0.0;
+        int seen = 0;
+        // 滑动中值：按到达顺序的环形窗口与同内容的有序数组
+        std::vector<double> window;
+        std::vector<double> sorted;
+        qsizetype windowHead = 0;
+        qsizetype windowCount = 0;
+        // 降采样：当前周期编号与相对周期起点的时间/数值累加
+        qint64 bucket = 0;
+        qint64 timeOffsetSum = 0;
+        double valueSum = 0.0;
+        qint64 bucketCount = 0;
+    };
+
+    bool feedEma(Stage &stage, qint64 &timeMs, double &value);
+    bool feedMedian(Stage &stage, qint64 &timeMs, double &value);
+    bool feedDownsample(Stage &stage, qint64 &timeMs, double &value);
+    bool feedOutlier(Stage &stage, qint64 &timeMs, double &value);
+    static void resetStage(Stage &stage);
+
+    std::vector<Stage> m_stages;
+    quint64 m_inputCount = 0;
+    quint64 m_outputCount = 0;
+    quint64 m_rejectedCount = 0;
+};
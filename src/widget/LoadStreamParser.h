@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QtEndian>
+#include <QtGlobal>
+
+#include <charconv>
+#include <cstring>
+
+// 流式样本解析：直接在读缓冲上解析，不为每行或每帧分配内存。
+// parse() 只处理完整的行/记录并返回已消费的字节数，末尾不完整的部分由调用方保留到下一次读取之后。
+// 每解析出一个样本调用一次 sink(timeMs, value)。
+
+// CSV：每行 “UTC 毫秒时间戳,负荷值”，分隔符可为逗号、分号、制表符或空格；
+// 空行与 # 开头的注释行跳过，无法解析的行（如表头）计入拒绝数。
+class LoadCsvParser {
+public:
+    template <typename Sink>
+    qsizetype parse(const char *data, qsizetype size, Sink &&sink);
+
+    // 单行超过读缓冲时由调用方整体丢弃，并计入拒绝数
+    void rejectLine() { ++m_rejectedLines; }
+    quint64 rejectedLines() const { return m_rejectedLines; }
+
+private:
+    static const char *skipBlanks(const char *first, const char *last) {
+        while (first != last && (*first == ' ' || *first == '\t')) ++first;
+        return first;
+    }
+    template <typename Sink>
+    void parseLine(const char *first, const char *last, Sink &sink);
+
+    quint64 m_rejectedLines = 0;
+};
+
+// 二进制：定长小端记录 { int64 UTC 毫秒时间戳; double 负荷值 }，记录之间无分隔
+class LoadBinaryParser {
+public:
+    static constexpr qsizetype RecordBytes = 16;
+
+    template <typename Sink>
+    qsizetype parse(const char *data, qsizetype size, Sink &&sink);
+};
+
+template <typename Sink>
+qsizetype LoadCsvParser::parse(const char *data, qsizetype size, Sink &&sink) {
+    const char *const end = data + size;
+    const char *line = data;
+    for (;;) {
+        const char *newline = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if (!newline) break;
+        const char *last = newline;
+        if (last != line && last[-1] == '\r') --last;
+        parseLine(line, last, sink);
+        line = newline + 1;
+    }
+    return line - data;
+}
+
+template <typename Sink>
+void LoadCsvParser::parseLine(const char *first, const char *last, Sink &sink) {
+    first = skipBlanks(first, last);
+    if (first == last || *first == '#') return;
+
+    qint64 timeMs = 0;
+    auto [timeEnd, timeError] = std::from_chars(first, last, timeMs);
+    if (timeError != std::errc()) {
+        ++m_rejectedLines;
+        return;
+    }
+    const char *cursor = skipBlanks(timeEnd, last);
+    if (cursor != last && (*cursor == ',' || *cursor == ';')) {
+        cursor = skipBlanks(cursor + 1, last);
+    } else if (cursor == timeEnd) {
+        ++m_rejectedLines;
+        return;
+    }
+
+    double value = 0.0;
+    auto [valueEnd, valueError] = std::from_chars(cursor, last, value);
+    // 负荷值之后允许附加列，忽略其内容
+    if (valueError != std::errc()
+        || (valueEnd != last && *valueEnd != ',' && *valueEnd != ';' && *valueEnd != ' ' && *valueEnd != '\t')) {
+        ++m_rejectedLines;
+        return;
+    }
+    sink(timeMs, value);
+}
+
+template <typename Sink>
+qsizetype LoadBinaryParser::parse(const char *data, qsizetype size, Sink &&sink) {
+    const qsizetype records = size / RecordBytes;
+    for (qsizetype i = 0; i < records; ++i) {
+        const char *record = data + i * RecordBytes;
+        // 读缓冲不保证对齐，按字节读取
+        const quint64 valueBits = qFromLittleEndian<quint64>(record + 8);
+        double value;
+        std::memcpy(&value, &valueBits, sizeof(value));
+        sink(qFromLittleEndian<qint64>(record), value);
+    }
+    return records * RecordBytes;
+}
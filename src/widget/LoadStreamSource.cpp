@@ -0,0 +1,314 @@
+#include "LoadStreamSource.h"
+#include "LoadSampleQueue.h"
+#include "LoadStreamParser.h"
+#include "LoadTimelineWidget.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QLocalSocket>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace {
+enum SourceKind {
+    FileSource = 0,
+    SocketSource = 1
+};
+
+// 管道读取：有数据即返回（QFile 对管道会等到读满请求长度才返回，实时流会被延迟）
+qint64 readAvailable(int fd, char *data, qint64 maxSize) {
+#ifdef Q_OS_WIN
+    return _read(fd, data, static_cast<unsigned>(qMin<qint64>(maxSize, 1 << 30)));
+#else
+    for (;;) {
+        const ssize_t result = ::read(fd, data, static_cast<size_t>(maxSize));
+        if (result >= 0 || errno != EINTR) return result;
+    }
+#endif
+}
+} // namespace
+
+struct LoadStreamSource::State {
+    SourceKind kind = FileSource;
+    QString name;
+    Format format = CsvFormat;
+    qsizetype batchSamples = 0;
+    qsizetype readBufferBytes = 0;
+    // 文件在 GUI 线程中打开后交给读取线程；套接字须在读取线程中创建
+    std::unique_ptr<QFile> file;
+    LoadSampleProducer producer;
+
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> finished{false};
+    bool reported = false;
+    std::atomic<quint64> bytesRead{0};
+    std::atomic<quint64> samplesParsed{0};
+    std::atomic<quint64> rejected{0};
+    std::atomic<quint64> backPressureWaits{0};
+
+    mutable QMutex errorMutex;
+    QString error;
+
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    bool done = false;
+    std::thread thread;
+
+    void setError(const QString &message) {
+        QMutexLocker locker(&errorMutex);
+        if (error.isEmpty()) error = message;
+    }
+};
+
+LoadStreamSource::LoadStreamSource(QObject *parent)
+    : QObject(parent) {
+    connect(&m_pollTimer, &QTimer::timeout, this, &LoadStreamSource::pollState);
+}
+
+LoadStreamSource::~LoadStreamSource() {
+    close();
+}
+
+void LoadStreamSource::setTarget(LoadTimelineWidget *widget, int seriesId) {
+    m_widget = widget;
+    m_seriesId = seriesId;
+}
+
+void LoadStreamSource::setBatchSamples(qsizetype samples) {
+    m_batchSamples = qMax<qsizetype>(1, samples);
+}
+
+void LoadStreamSource::setReadBufferBytes(qsizetype bytes) {
+    // 至少容纳一条二进制记录
+    m_readBufferBytes = qMax<qsizetype>(LoadBinaryParser::RecordBytes * 64, bytes);
+}
+
+bool LoadStreamSource::openFile(const QString &path, Format format) {
+    return start(FileSource, path, format);
+}
+
+bool LoadStreamSource::connectToServer(const QString &serverName, Format format) {
+    return start(SocketSource, serverName, format);
+}
+
+bool LoadStreamSource::start(int kind, const QString &name, Format format) {
+    close();
+    if (!m_widget) return false;
+
+    auto state = std::make_shared<State>();
+    state->kind = static_cast<SourceKind>(kind);
+    state->name = name;
+    state->format = format;
+    state->batchSamples = m_batchSamples;
+    state->readBufferBytes = m_readBufferBytes;
+    if (kind == FileSource) {
+        state->file = std::make_unique<QFile>();
+        const bool opened = name == QLatin1String("-")
+            ? state->file->open(stdin, QIODevice::ReadOnly)
+            : (state->file->setFileName(name), state->file->open(QIODevice::ReadOnly));
+        if (!opened) {
+            state->error = state->file->errorString();
+            emit errorOccurred(state->error);
+            return false;
+        }
+    }
+
+    // 队列容纳若干批：控件每帧整体取出，读取线程只在控件跟不上时等待
+    state->producer = m_widget->createSeriesProducer(m_seriesId, m_batchSamples * 16);
+    if (!state->producer.isValid()) return false;
+
+    m_state = state;
+    state->thread = std::thread([state]() { run(state); });
+    m_pollTimer.start(100);
+    return true;
+}
+
+void LoadStreamSource::close() {
+    m_pollTimer.stop();
+    if (!m_state) return;
+
+    std::shared_ptr<State> state = std::move(m_state);
+    state->stopRequested = true;
+    if (state->thread.joinable()) {
+        std::unique_lock<std::mutex> lock(state->doneMutex);
+        const bool done = state->doneCondition.wait_for(lock, std::chrono::milliseconds(500),
+                                                        [&state]() { return state->done; });
+        lock.unlock();
+        if (done) {
+            state->thread.join();
+        } else {
+            // 读取线程阻塞在管道上：共享状态随线程存活，读到数据或管道关闭后自行退出
+            state->thread.detach();
+        }
+    }
+}
+
+bool LoadStreamSource::isRunning() const {
+    return m_state && !m_state->finished;
+}
+
+quint64 LoadStreamSource::bytesRead() const {
+    return m_state ? m_state->bytesRead.load() : 0;
+}
+
+quint64 LoadStreamSource::samplesParsed() const {
+    return m_state ? m_state->samplesParsed.load() : 0;
+}
+
+quint64 LoadStreamSource::rejectedRecords() const {
+    return m_state ? m_state->rejected.load() : 0;
+}
+
+quint64 LoadStreamSource::backPressureWaits() const {
+    return m_state ? m_state->backPressureWaits.load() : 0;
+}
+
+QString LoadStreamSource::errorString() const {
+    if (!m_state) return QString();
+    QMutexLocker locker(&m_state->errorMutex);
+    return m_state->error;
+}
+
+void LoadStreamSource::pollState() {
+    if (!m_state || !m_state->finished || m_state->reported) return;
+    m_state->reported = true;
+    m_pollTimer.stop();
+    const QString error = errorString();
+    if (!error.isEmpty()) {
+        emit errorOccurred(error);
+    }
+    emit finished();
+}
+
+void LoadStreamSource::run(const std::shared_ptr<State> &state) {
+    std::unique_ptr<QLocalSocket> socket;
+    if (state->kind == SocketSource) {
+        socket = std::make_unique<QLocalSocket>();
+        socket->connectToServer(state->name, QIODevice::ReadOnly);
+        if (!socket->waitForConnected(3000)) {
+            state->setError(socket->errorString());
+        }
+    }
+
+    QVector<qint64> times;
+    QVector<double> values;
+    times.reserve(state->batchSamples);
+    values.reserve(state->batchSamples);
+    // 整批写入队列；队列已满时等待控件取出，不丢弃样本
+    auto flush = [&]() {
+        qsizetype offset = 0;
+        const qsizetype count = times.size();
+        while (offset < count && !state->stopRequested) {
+            offset += state->producer.pushBatch(times.constData() + offset, values.constData() + offset,
+                                                count - offset);
+            if (offset < count) {
+                ++state->backPressureWaits;
+                QThread::msleep(1);
+            }
+        }
+        state->samplesParsed += offset;
+        times.resize(0);
+        values.resize(0);
+    };
+    auto sink = [&](qint64 timeMs, double value) {
+        times.append(timeMs);
+        values.append(value);
+        if (times.size() >= state->batchSamples) flush();
+    };
+
+    LoadCsvParser csvParser;
+    LoadBinaryParser binaryParser;
+    const bool csv = state->format == CsvFormat;
+    auto parse = [&](const char *bytes, qsizetype size) {
+        return csv ? csvParser.parse(bytes, size, sink) : binaryParser.parse(bytes, size, sink);
+    };
+
+    QFile *file = state->file.get();
+    const bool pipe = file && file->isSequential();
+    QByteArray buffer(state->readBufferBytes, Qt::Uninitialized);
+    char *const data = buffer.data();
+    qsizetype carry = 0;
+    bool discardingLine = false;
+
+    while (!state->stopRequested && (file || socket->state() == QLocalSocket::ConnectedState
+                                     || socket->bytesAvailable() > 0)) {
+        qint64 read = 0;
+        if (socket) {
+            // 定时醒来检查停止请求；断开后先读完已缓冲的数据
+            if (socket->bytesAvailable() == 0 && !socket->waitForReadyRead(100)) continue;
+            read = socket->read(data + carry, buffer.size() - carry);
+        } else if (pipe) {
+            read = readAvailable(file->handle(), data + carry, buffer.size() - carry);
+        } else {
+            read = file->read(data + carry, buffer.size() - carry);
+        }
+        if (read < 0) {
+            state->setError(socket ? socket->errorString() : file->errorString());
+            break;
+        }
+        if (read == 0) {
+            if (socket) continue;
+            break; // 文件读完或管道写端关闭
+        }
+        state->bytesRead += read;
+
+        qsizetype begin = 0;
+        const qsizetype available = carry + read;
+        if (discardingLine) {
+            // 跳过超长行的剩余部分
+            const char *newline = static_cast<const char *>(std::memchr(data, '\n', available));
+            if (!newline) {
+                carry = 0;
+                continue;
+            }
+            begin = newline + 1 - data;
+            discardingLine = false;
+        }
+        const qsizetype consumed = parse(data + begin, available - begin);
+        carry = available - begin - consumed;
+        if (carry == buffer.size()) {
+            // 单行超过读缓冲：整行丢弃
+            csvParser.rejectLine();
+            discardingLine = true;
+            carry = 0;
+        } else if (carry > 0) {
+            std::memmove(data, data + begin + consumed, static_cast<size_t>(carry));
+        }
+        flush();
+        state->rejected = csvParser.rejectedLines();
+    }
+
+    // 末行可能没有换行符
+    if (csv && carry > 0 && carry < buffer.size() && !discardingLine && !state->stopRequested) {
+        data[carry] = '\n';
+        parse(data, carry + 1);
+    }
+    flush();
+    state->rejected = csvParser.rejectedLines();
+    // 释放生产者句柄：模型取完积压样本后回收队列，不再为已结束的读取线程保留
+    state->producer = LoadSampleProducer();
+    state->finished = true;
+
+    {
+        std::lock_guard<std::mutex> lock(state->doneMutex);
+        state->done = true;
+    }
+    state->doneCondition.notify_all();
+}
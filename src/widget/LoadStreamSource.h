@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QtGlobal>
+
+#include <memory>
+
+class LoadTimelineWidget;
+
+// 流式数据源：在后台线程读取文件、管道（标准输入）或 QLocalSocket，
+// 用 LoadCsvParser / LoadBinaryParser 在读缓冲上原地解析，按批写入控件的生产者队列。
+// 队列写满时读取线程暂停读取等待控件取出（背压），上游写入方随之被操作系统缓冲区阻塞，不丢样本。
+class LoadStreamSource : public QObject {
+    Q_OBJECT
+
+public:
+    enum Format {
+        CsvFormat = 0,
+        BinaryFormat = 1
+    };
+    Q_ENUM(Format)
+
+    explicit LoadStreamSource(QObject *parent = nullptr);
+    ~LoadStreamSource() override;
+
+    // 写入目标：须在 open 之前设置（默认主序列）
+    void setTarget(LoadTimelineWidget *widget, int seriesId = 0);
+
+    // 读取文件；路径为 "-" 时读取标准输入
+    bool openFile(const QString &path, Format format);
+    // 连接本地套接字服务端（QLocalServer 名称）
+    bool connectToServer(const QString &serverName, Format format);
+    void close();
+    bool isRunning() const;
+
+    // 单批样本数上限（同时决定生产者队列容量）与读缓冲大小，须在 open 之前设置
+    void setBatchSamples(qsizetype samples);
+    qsizetype batchSamples() const { return m_batchSamples; }
+    void setReadBufferBytes(qsizetype bytes);
+    qsizetype readBufferBytes() const { return m_readBufferBytes; }
+
+    // 运行统计（可在任意时刻读取）
+    quint64 bytesRead() const;
+    quint64 samplesParsed() const;
+    quint64 rejectedRecords() const;
+    // 因队列写满而等待的次数
+    quint64 backPressureWaits() const;
+    QString errorString() const;
+
+signals:
+    // 数据源结束（文件读完、管道关闭或连接断开）
+    void finished();
+    void errorOccurred(const QString &message);
+
+private:
+    struct State;
+    bool start(int kind, const QString &name, Format format);
+    // 读取线程主体：只访问共享状态，控件与本对象销毁后仍可安全结束
+    static void run(const std::shared_ptr<State> &state);
+    void pollState();
+
+    std::shared_ptr<State> m_state;
+    LoadTimelineWidget *m_widget = nullptr;
+    int m_seriesId = 0;
+    qsizetype m_batchSamples = 4096;
+    qsizetype m_readBufferBytes = 256 * 1024;
+    // 读取线程结束与出错只记录在共享状态中，由 GUI 线程轮询后发出信号
+    QTimer m_pollTimer;
+};
@@ -0,0 +1,579 @@
+#include "LoadTimelineModel.h"
+#include "LoadFrameScheduler.h"
+
+#include <QTimeZone>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+// 每个原始样本在缓冲区中的字节数（时间戳 + 负荷值）
+constexpr qint64 kRawSampleBytes = sizeof(qint64) + sizeof(double);
+// 没有视图登记时间窗口时的保留窗口
+constexpr int kDefaultWindowSeconds = 60;
+// 录制时未写满数据块的定时写出间隔：进程异常退出时最多丢失这段时间内的样本
+constexpr int kRecorderFlushIntervalMs = 1000;
+
+// 无效时间戳视为最早时刻，保持与 QDateTime 比较一致（会被优先裁剪）
+qint64 toEpochMsecs(const QDateTime &timestamp) {
+    return timestamp.isValid() ? timestamp.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+}
+} // namespace
+
+LoadTimelineModel::LoadTimelineModel(QObject *parent)
+    : QObject(parent) {
+    auto primary = std::make_unique<Series>();
+    primary->color = QColor(0, 96, 180);
+    initSeries(*primary);
+    m_series.push_back(std::move(primary));
+
+    m_recorderFlushTimer.setInterval(kRecorderFlushIntervalMs);
+    connect(&m_recorderFlushTimer, &QTimer::timeout, this, [this]() {
+        if (m_recorder && !m_recorder->flush()) {
+            emit recordingError(m_recorder->errorString());
+        }
+    });
+}
+
+LoadTimelineModel::~LoadTimelineModel() {
+    LoadFrameScheduler::release(this);
+}
+
+int LoadTimelineModel::addSeries(const QString &name, const QColor &color) {
+    auto series = std::make_unique<Series>();
+    series->id = m_nextSeriesId++;
+    series->name = name;
+    series->color = color;
+    initSeries(*series);
+    const int id = series->id;
+    m_series.push_back(std::move(series));
+    // 预算按序列数分配，新增序列后重新配置汇总层
+    applyRetention();
+    emit seriesAdded(id);
+    return id;
+}
+
+bool LoadTimelineModel::removeSeries(int seriesId) {
+    if (seriesId == PrimarySeriesId) return false;
+    auto it = std::find_if(m_series.begin(), m_series.end(),
+                           [seriesId](const std::unique_ptr<Series> &series) { return series->id == seriesId; });
+    if (it == m_series.end()) return false;
+
+    m_series.erase(it);
+    applyRetention();
+    emit seriesRemoved(seriesId);
+    return true;
+}
+
+QList<int> LoadTimelineModel::seriesIds() const {
+    QList<int> ids;
+    ids.reserve(static_cast<qsizetype>(m_series.size()));
+    for (const auto &series : m_series) {
+        ids.append(series->id);
+    }
+    return ids;
+}
+
+LoadTimelineModel::Series *LoadTimelineModel::findSeries(int seriesId) {
+    return const_cast<Series *>(static_cast<const LoadTimelineModel *>(this)->findSeries(seriesId));
+}
+
+const LoadTimelineModel::Series *LoadTimelineModel::findSeries(int seriesId) const {
+    // 序列按编号递增排列，二分查找
+    auto it = std::lower_bound(m_series.begin(), m_series.end(), seriesId,
+                               [](const std::unique_ptr<Series> &series, int id) { return series->id < id; });
+    return (it != m_series.end() && (*it)->id == seriesId) ? it->get() : nullptr;
+}
+
+QString LoadTimelineModel::seriesName(int seriesId) const {
+    const Series *series = findSeries(seriesId);
+    return series ? series->name : QString();
+}
+
+void LoadTimelineModel::setSeriesName(int seriesId, const QString &name) {
+    Series *series = findSeries(seriesId);
+    if (!series || series->name == name) return;
+    series->name = name;
+    emit seriesChanged(seriesId);
+}
+
+QColor LoadTimelineModel::seriesColor(int seriesId) const {
+    const Series *series = findSeries(seriesId);
+    return series ? series->color : QColor();
+}
+
+void LoadTimelineModel::setSeriesColor(int seriesId, const QColor &color) {
+    Series *series = findSeries(seriesId);
+    if (!series || series->color == color) return;
+    series->color = color;
+    emit seriesChanged(seriesId);
+}
+
+void LoadTimelineModel::appendSample(int seriesId, const Sample &sample) {
+    Series *series = findSeries(seriesId);
+    if (!series) return;
+    const qint64 begin = endSequence(*series);
+    storeSample(*series, toEpochMsecs(sample.timestamp), sample.loadValue);
+    finishAppend(*series, begin);
+}
+
+void LoadTimelineModel::appendSamples(int seriesId, const Sample *samples, qsizetype count) {
+    Series *series = findSeries(seriesId);
+    if (!series || !samples || count <= 0) return;
+    const qint64 begin = endSequence(*series);
+    for (qsizetype i = 0; i < count; ++i) {
+        storeSample(*series, toEpochMsecs(samples[i].timestamp), samples[i].loadValue);
+    }
+    finishAppend(*series, begin);
+}
+
+void LoadTimelineModel::appendSamples(int seriesId, const qint64 *timesMs, const double *values, qsizetype count) {
+    Series *series = findSeries(seriesId);
+    if (!series || !timesMs || !values || count <= 0) return;
+    const qint64 begin = endSequence(*series);
+    for (qsizetype i = 0; i < count; ++i) {
+        storeSample(*series, timesMs[i], values[i]);
+    }
+    finishAppend(*series, begin);
+}
+
+void LoadTimelineModel::finishAppend(Series &series, qint64 beginSequence) {
+    pruneOutdatedSamples();
+    // 样本全部被信号调理吸收时不通知
+    const int seriesId = series.id;
+    const qint64 end = endSequence(series);
+    if (end > beginSequence) {
+        emit samplesAppended(seriesId, beginSequence, end);
+    }
+    emitZoneTransitions();
+}
+
+void LoadTimelineModel::emitZoneTransitions() {
+    // 先取走整批记录：槽函数中再次追加样本时嵌套调用只发出新产生的切换
+    std::vector<ZoneTransition> transitions;
+    transitions.swap(m_pendingZoneTransitions);
+    for (const ZoneTransition &transition : transitions) {
+        emit loadZoneChanged(transition.seriesId, transition.previousZone, transition.currentZone,
+                             QDateTime::fromMSecsSinceEpoch(transition.timeMs, QTimeZone::UTC));
+    }
+}
+
+void LoadTimelineModel::setSamples(int seriesId, const QVector<Sample> &samples) {
+    Series *series = findSeries(seriesId);
+    if (!series) return;
+    series->buffer.clear();
+    // 设有内存预算时不按输入整体预留：由 storeSample 的按预算扩容决定容量，超出时压缩最旧样本
+    if (m_memoryBudgetBytes <= 0) {
+        series->buffer.reserve(samples.size());
+    }
+    series->extrema.clear();
+    ++series->dataGeneration;
+    series->pyramid.reset();
+    series->statistics.reset();
+    series->zoneTracker.reset();
+    series->pipeline.reset();
+    series->tiers.reset();
+    // 缓冲区、抽稀索引与统计都要求时间非降序：乱序输入先按时间稳定排序（同一时刻的样本保持输入顺序）
+    std::vector<std::pair<qint64, double>> ordered;
+    ordered.reserve(static_cast<size_t>(samples.size()));
+    for (const Sample &sample : samples) {
+        ordered.emplace_back(toEpochMsecs(sample.timestamp), sample.loadValue);
+    }
+    auto earlier = [](const std::pair<qint64, double> &a, const std::pair<qint64, double> &b) {
+        return a.first < b.first;
+    };
+    if (!std::is_sorted(ordered.begin(), ordered.end(), earlier)) {
+        std::stable_sort(ordered.begin(), ordered.end(), earlier);
+    }
+    // 整体替换的是历史数据，不写入录制归档（归档只追加实时接入的样本）
+    for (const auto &[timeMs, value] : ordered) {
+        storeSample(*series, timeMs, value, false);
+    }
+    pruneOutdatedSamples();
+    emit samplesReset(seriesId);
+    emitZoneTransitions();
+}
+
+QVector<LoadTimelineModel::Sample> LoadTimelineModel::samples(int seriesId) const {
+    QVector<Sample> result;
+    const Series *series = findSeries(seriesId);
+    if (!series) return result;
+
+    const LoadSampleBuffer &buffer = series->buffer;
+    result.reserve(buffer.size());
+    for (qsizetype i = 0; i < buffer.size(); ++i) {
+        Sample sample;
+        sample.timestamp = QDateTime::fromMSecsSinceEpoch(buffer.timeAt(i), QTimeZone::UTC);
+        sample.loadValue = buffer.valueAt(i);
+        result.append(sample);
+    }
+    return result;
+}
+
+void LoadTimelineModel::setIngestPipeline(int seriesId, const LoadSignalPipeline &pipeline) {
+    Series *series = findSeries(seriesId);
+    if (!series) return;
+    series->pipeline = pipeline;
+    series->pipeline.reset();
+}
+
+LoadSignalPipeline LoadTimelineModel::ingestPipeline(int seriesId) const {
+    const Series *series = findSeries(seriesId);
+    return series ? series->pipeline : LoadSignalPipeline();
+}
+
+quint64 LoadTimelineModel::addAnnotation(const QDateTime &timestamp, const QString &label, const QColor &color) {
+    return addAnnotation(timestamp, timestamp, label, color);
+}
+
+quint64 LoadTimelineModel::addAnnotation(const QDateTime &start, const QDateTime &end, const QString &label,
+                                         const QColor &color) {
+    const quint64 id = m_annotations.insert(toEpochMsecs(start), toEpochMsecs(end), label, color);
+    emit annotationsChanged();
+    return id;
+}
+
+bool LoadTimelineModel::removeAnnotation(quint64 id) {
+    if (!m_annotations.remove(id)) return false;
+    emit annotationsChanged();
+    return true;
+}
+
+void LoadTimelineModel::clearAnnotations() {
+    m_annotations.clear();
+    emit annotationsChanged();
+}
+
+void LoadTimelineModel::setThresholds(double medium, double high) {
+    if (qFuzzyCompare(medium, m_mediumThreshold) && qFuzzyCompare(high, m_highThreshold)) return;
+    m_mediumThreshold = medium;
+    m_highThreshold = high;
+    // 按新分区规则重算驻留时长
+    for (const auto &series : m_series) {
+        series->statistics.setThresholds(medium, high);
+        series->statistics.recompute(series->buffer);
+    }
+    emit thresholdsChanged(medium, high);
+}
+
+void LoadTimelineModel::setZoneHysteresis(double value) {
+    value = qMax(0.0, value);
+    if (qFuzzyCompare(value, m_zoneHysteresis)) return;
+    m_zoneHysteresis = value;
+    for (const auto &series : m_series) {
+        series->zoneTracker.setHysteresis(value);
+    }
+    emit zoneHysteresisChanged(value);
+}
+
+void LoadTimelineModel::setZoneDebounceMs(int ms) {
+    if (ms < 0 || ms == m_zoneDebounceMs) return;
+    m_zoneDebounceMs = ms;
+    for (const auto &series : m_series) {
+        series->zoneTracker.setDebounceMs(ms);
+    }
+    emit zoneDebounceMsChanged(ms);
+}
+
+LoadZoneStatistics::Dwell LoadTimelineModel::zoneDwell(int seriesId) const {
+    const Series *series = findSeries(seriesId);
+    if (!series) return LoadZoneStatistics::Dwell();
+    // 原始样本部分与已汇总部分之和
+    LoadZoneStatistics::Dwell dwell = series->statistics.dwell();
+    for (int zone = 0; zone < LoadZoneStatistics::ZoneCount; ++zone) {
+        dwell.zoneMs[zone] += series->tiers.dwell().zoneMs[zone];
+    }
+    return dwell;
+}
+
+void LoadTimelineModel::setRawRetentionSeconds(int seconds) {
+    if (seconds < 0 || seconds == m_rawRetentionSeconds) return;
+    m_rawRetentionSeconds = seconds;
+    applyRetention();
+    emit rawRetentionSecondsChanged(seconds);
+}
+
+void LoadTimelineModel::setMemoryBudgetBytes(qint64 bytes) {
+    if (bytes < 0 || bytes == m_memoryBudgetBytes) return;
+    m_memoryBudgetBytes = bytes;
+    applyRetention();
+    emit memoryBudgetBytesChanged(bytes);
+}
+
+void LoadTimelineModel::setRetentionTiers(const QVector<LoadRetentionTiers::Tier> &tiers) {
+    m_retentionTiers = tiers.isEmpty() ? LoadRetentionTiers::defaultTiers() : tiers;
+    applyRetention();
+}
+
+qint64 LoadTimelineModel::memoryUsageBytes() const {
+    qint64 bytes = 0;
+    for (const auto &series : m_series) {
+        bytes += qint64(sizeof(Series)) + qint64(series->buffer.capacity()) * kRawSampleBytes
+            + series->pyramid.memoryBytes() + series->tiers.memoryBytes();
+    }
+    return bytes;
+}
+
+void LoadTimelineModel::setViewWindow(const QObject *view, int seconds) {
+    auto it = std::find_if(m_viewWindows.begin(), m_viewWindows.end(),
+                           [view](const std::pair<const QObject *, int> &entry) { return entry.first == view; });
+    if (it != m_viewWindows.end()) {
+        it->second = seconds;
+    } else {
+        m_viewWindows.emplace_back(view, seconds);
+    }
+    updateWindow();
+}
+
+void LoadTimelineModel::removeView(const QObject *view) {
+    m_viewWindows.erase(std::remove_if(m_viewWindows.begin(), m_viewWindows.end(),
+                                       [view](const std::pair<const QObject *, int> &entry) { return entry.first == view; }),
+                        m_viewWindows.end());
+    updateWindow();
+}
+
+void LoadTimelineModel::setMinimumWindowSeconds(int seconds) {
+    if (seconds < 0 || seconds == m_minimumWindowSeconds) return;
+    m_minimumWindowSeconds = seconds;
+    updateWindow();
+}
+
+void LoadTimelineModel::updateWindow() {
+    int seconds = m_minimumWindowSeconds;
+    for (const auto &entry : m_viewWindows) {
+        seconds = qMax(seconds, entry.second);
+    }
+    if (seconds <= 0) seconds = kDefaultWindowSeconds;
+    if (seconds == m_windowSeconds) return;
+    m_windowSeconds = seconds;
+    // 汇总层的覆盖范围随保留窗口变化；同时裁剪窗口之外的样本
+    applyRetention();
+    emit timeWindowSecondsChanged(seconds);
+}
+
+void LoadTimelineModel::setClock(std::shared_ptr<LoadClock> clock) {
+    if (!clock) clock = LoadClock::systemClock();
+    if (clock == m_clock) return;
+    m_clock = std::move(clock);
+    pruneOutdatedSamples();
+}
+
+bool LoadTimelineModel::startRecording(const QString &path) {
+    auto recorder = std::make_unique<LoadSessionWriter>();
+    if (!recorder->open(path)) return false;
+    m_recorder = std::move(recorder);
+    m_recordingRejectedCount = 0;
+    // 写入器只在数据块写满时自动写出；定时写出未满部分，每次只写上次写出之后的新样本
+    m_recorderFlushTimer.start();
+    return true;
+}
+
+void LoadTimelineModel::stopRecording() {
+    m_recorderFlushTimer.stop();
+    // 析构时写出未满的数据块
+    m_recorder.reset();
+}
+
+LoadSampleProducer LoadTimelineModel::createProducer(int seriesId, qsizetype capacity) {
+    if (!findSeries(seriesId)) return LoadSampleProducer();
+
+    ProducerQueue entry;
+    entry.queue = std::make_shared<LoadSampleQueue>(capacity);
+    entry.seriesId = seriesId;
+    // 队列挂起后的首次写入在生产者线程中唤醒帧调度器（调度器随应用对象存在）；
+    // 新队列以挂起状态交出，节拍已停止时首批样本同样能唤醒
+    LoadFrameScheduler *scheduler = LoadFrameScheduler::instance();
+    entry.queue->setWakeHandler([scheduler]() { scheduler->wake(); });
+    entry.queue->park();
+    m_producerQueues.push_back(entry);
+    if (m_producerQueues.size() == 1) {
+        LoadFrameScheduler::instance()->setDrainRequired(this, true);
+    }
+    return LoadSampleProducer(entry.queue);
+}
+
+qsizetype LoadTimelineModel::queuedSampleCount() const {
+    qsizetype total = 0;
+    for (const ProducerQueue &entry : m_producerQueues) {
+        total += entry.queue->size();
+    }
+    return total;
+}
+
+quint64 LoadTimelineModel::droppedSampleCount() const {
+    quint64 total = m_retiredDroppedCount;
+    for (const ProducerQueue &entry : m_producerQueues) {
+        total += entry.queue->droppedCount();
+    }
+    return total;
+}
+
+bool LoadTimelineModel::drainProducerQueues() {
+    // 按序列编号记录取出前的末尾序号，整拍取完后每条序列只通知一次
+    std::vector<std::pair<int, qint64>> begins;
+    begins.reserve(m_series.size());
+    for (const auto &series : m_series) {
+        begins.emplace_back(series->id, endSequence(*series));
+    }
+
+    qsizetype drained = 0;
+    bool active = false;
+    for (auto it = m_producerQueues.begin(); it != m_producerQueues.end();) {
+        const std::shared_ptr<LoadSampleQueue> &queue = it->queue;
+        Series *series = findSeries(it->seriesId);
+        qsizetype count = 0;
+        if (series) {
+            count = queue->drain([this, series](qint64 timeMs, double value) { storeSample(*series, timeMs, value); });
+            drained += count;
+        } else {
+            // 目标序列已移除：丢弃积压样本
+            count = queue->drain([](qint64, double) {});
+        }
+
+        // 所有生产者句柄均已释放且队列已空时回收
+        if (queue.use_count() == 1 && queue->size() == 0) {
+            m_retiredDroppedCount += queue->droppedCount();
+            it = m_producerQueues.erase(it);
+            continue;
+        }
+        // 本拍没有取到样本的空队列挂起，等下次写入唤醒；持续写入的队列保持活动，不必每拍唤醒
+        if (count > 0 || !queue->park()) active = true;
+        ++it;
+    }
+
+    if (m_producerQueues.empty()) {
+        LoadFrameScheduler::instance()->setDrainRequired(this, false);
+    }
+    if (drained == 0) return active;
+    pruneOutdatedSamples();
+    // 槽函数可能增删序列：每次通知前按编号重新查找
+    for (const auto &begin : begins) {
+        const Series *series = findSeries(begin.first);
+        if (!series) continue;
+        const qint64 end = endSequence(*series);
+        if (end > begin.second) emit samplesAppended(begin.first, begin.second, end);
+    }
+    emitZoneTransitions();
+    return active;
+}
+
+void LoadTimelineModel::initSeries(Series &series) {
+    series.statistics.setThresholds(m_mediumThreshold, m_highThreshold);
+    series.zoneTracker.setHysteresis(m_zoneHysteresis);
+    series.zoneTracker.setDebounceMs(m_zoneDebounceMs);
+}
+
+bool LoadTimelineModel::retentionActive() const {
+    return m_rawRetentionSeconds > 0 && m_rawRetentionSeconds < m_windowSeconds;
+}
+
+void LoadTimelineModel::applyRetention() {
+    const qint64 now = m_clock->nowMs();
+    // 每条序列的汇总层最多占用其预算份额的一半，其余留给原始样本
+    const qint64 tierBytes =
+        m_memoryBudgetBytes > 0 && !m_series.empty() ? m_memoryBudgetBytes / (2 * qint64(m_series.size())) : 0;
+    for (const auto &series : m_series) {
+        if (retentionActive()) {
+            series->tiers.configure(m_retentionTiers, qint64(m_rawRetentionSeconds) * 1000,
+                                    qint64(m_windowSeconds) * 1000, tierBytes, now);
+        } else if (series->tiers.isEnabled()) {
+            series->tiers.disable();
+        }
+    }
+    pruneOutdatedSamples();
+    enforceMemoryBudget();
+    emit retentionChanged();
+}
+
+void LoadTimelineModel::enforceMemoryBudget() {
+    if (m_memoryBudgetBytes <= 0) return;
+    const qint64 windowStart = m_clock->nowMs() - qint64(m_windowSeconds) * 1000;
+    while (memoryUsageBytes() > m_memoryBudgetBytes) {
+        Series *largest = nullptr;
+        for (const auto &series : m_series) {
+            if (!largest || series->buffer.capacity() > largest->buffer.capacity()) largest = series.get();
+        }
+        if (!largest || largest->buffer.capacity() <= 16) break;
+
+        // 容量减半：先把超出的最旧样本移出（折叠进汇总层），再释放存储
+        const qsizetype target = largest->buffer.capacity() / 2;
+        if (largest->buffer.size() > target) {
+            compactFront(*largest, largest->buffer.size() - target, windowStart);
+        }
+        largest->buffer.squeeze(target);
+        largest->pyramid.squeeze();
+    }
+}
+
+void LoadTimelineModel::pruneOutdatedSamples() {
+    const qint64 now = m_clock->nowMs();
+    const qint64 bound = now - qint64(m_windowSeconds) * 1000;
+    // 分层保留时原始样本只保留最近 rawRetentionSeconds，更早的折叠进汇总层
+    const qint64 rawBound = retentionActive() ? now - qint64(m_rawRetentionSeconds) * 1000 : bound;
+    for (const auto &series : m_series) {
+        compactFront(*series, series->buffer.countBefore(rawBound), bound);
+        if (series->tiers.isEnabled()) {
+            series->tiers.advance(now, bound);
+        }
+    }
+    m_annotations.expireBefore(bound);
+}
+
+void LoadTimelineModel::compactFront(Series &series, qsizetype count, qint64 windowStartMs) {
+    if (count <= 0) return;
+    LoadSampleBuffer &buffer = series.buffer;
+    if (series.tiers.isEnabled()) {
+        for (qsizetype i = 0; i < count; ++i) {
+            const qint64 timeMs = buffer.timeAt(i);
+            if (timeMs < windowStartMs) continue;
+            // 与分区统计一致：样本到后继样本的间隔计入该样本所在分区
+            const qint64 dwellMs = i + 1 < buffer.size() ? buffer.timeAt(i + 1) - timeMs : 0;
+            series.tiers.fold(timeMs, buffer.valueAt(i), dwellMs, series.statistics.zoneFor(buffer.valueAt(i)));
+        }
+    }
+    if (!series.tiers.isEnabled()) {
+        // 未启用分层保留时窗口内的样本被直接丢弃（内存预算所致），计入移出数
+        m_evictedSampleCount += quint64(qMax<qsizetype>(0, count - buffer.countBefore(windowStartMs)));
+    }
+    series.statistics.samplesRemoving(buffer, count);
+    buffer.dropFront(count);
+    series.pyramid.dropBefore(buffer.firstSequence());
+    series.extrema.dropBefore(buffer.firstSequence());
+}
+
+void LoadTimelineModel::storeSample(Series &series, qint64 timeMs, double value, bool record) {
+    ++m_samplesIngested;
+    // 信号调理：降采样周期未结束或样本被剔除时本次不存储
+    if (!series.pipeline.isEmpty() && !series.pipeline.process(timeMs, value)) return;
+    const qint64 sequence = series.buffer.firstSequence() + series.buffer.size();
+    bool grew = false;
+    if (m_memoryBudgetBytes > 0) {
+        // 原始缓冲或抽稀索引扩容会超出内存预算时改为移出最旧的一半样本（折叠进汇总层），存储不再增长
+        const qint64 rawGrowth = series.buffer.size() == series.buffer.capacity()
+            ? qint64(series.buffer.capacity()) * kRawSampleBytes
+            : 0;
+        const qint64 growth = rawGrowth + series.pyramid.growthBytes(sequence);
+        if (growth > 0 && memoryUsageBytes() + growth > m_memoryBudgetBytes && series.buffer.size() > 1) {
+            compactFront(series, series.buffer.size() / 2, m_clock->nowMs() - qint64(m_windowSeconds) * 1000);
+        }
+        grew = series.buffer.size() == series.buffer.capacity();
+    }
+    grew = series.pyramid.append(sequence, timeMs, value) || grew;
+    series.buffer.append(timeMs, value);
+    // 移出样本后仍需扩容（如抽稀索引的头部空间不足）时按预算整体压缩
+    if (grew && m_memoryBudgetBytes > 0 && memoryUsageBytes() > m_memoryBudgetBytes) {
+        enforceMemoryBudget();
+    }
+    series.extrema.append(series.buffer.firstSequence() + series.buffer.size() - 1, value);
+    series.statistics.sampleAppended(series.buffer);
+    if (record && m_recorder && series.id == PrimarySeriesId && !m_recorder->append(timeMs, value)) {
+        // 写入器拒绝早于上一个录制样本的时间戳；写入失败同样计入
+        ++m_recordingRejectedCount;
+    }
+
+    // 分区切换先记录，整批存储与追加通知完成后再发出：槽函数可能增删序列或生产者队列
+    if (series.zoneTracker.feed(timeMs, value, m_mediumThreshold, m_highThreshold)) {
+        m_pendingZoneTransitions.push_back(
+            {series.id, series.zoneTracker.previousZone(), series.zoneTracker.zone(), timeMs});
+    }
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <QColor>
+#include <QDateTime>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include "LoadAnnotationIndex.h"
+#include "LoadClock.h"
+#include "LoadDecimationPyramid.h"
+#include "LoadRetentionTiers.h"
+#include "LoadSampleBuffer.h"
+#include "LoadSampleQueue.h"
+#include "LoadSessionArchive.h"
+#include "LoadSignalPipeline.h"
+#include "LoadWindowExtrema.h"
+#include "LoadZoneStatistics.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+// 负荷时间轴数据模型：持有各序列的样本存储、抽稀索引、分区统计、分层保留与标注，负责接入、裁剪与录制。
+// 多个控件可附着到同一个模型（仪表盘缩略图、放大的细节视图、报表预览），各自按自己的时间窗口与外观绘制，
+// 接入与存储只有一份。控件通过 seriesAt()/findSeries() 的常量引用直接读取存储，不复制样本；
+// 数据变化以信号通知，追加通知携带新样本的序号范围。保留范围取附着视图中最长的时间窗口。
+// 仅在 GUI 线程中使用；其他线程通过生产者队列写入，由帧调度器按节拍取出。
+class LoadTimelineModel : public QObject {
+    Q_OBJECT
+
+public:
+    // 数据结构：时间戳 + 负荷值
+    struct Sample {
+        QDateTime timestamp;
+        double loadValue = 0.0;
+    };
+
+    // 主序列编号：主序列随模型创建，不可移除
+    static constexpr int PrimarySeriesId = 0;
+
+    // 单条序列的数据；视图只读，样本以缓冲区序号定位
+    struct Series {
+        int id = PrimarySeriesId;
+        QString name;
+        QColor color;
+        // 样本存储：环形缓冲区，时间戳与负荷值分列存放
+        LoadSampleBuffer buffer;
+        // 最小/最大值抽稀索引，保证绘制开销只与像素宽度相关
+        LoadDecimationPyramid pyramid;
+        // 分区驻留统计与切换判定
+        LoadZoneStatistics statistics;
+        LoadZoneTracker zoneTracker;
+        // 接入信号调理，写入缓冲区之前应用
+        LoadSignalPipeline pipeline;
+        // 分层保留：离开原始保留时长的样本折叠为汇总桶
+        LoadRetentionTiers tiers;
+        // 原始样本的滑动窗口极值（自动量程），随追加与裁剪增量维护
+        LoadWindowExtrema extrema;
+        // 整体替换数据时递增，视图据此重建路径缓存
+        quint64 dataGeneration = 0;
+    };
+
+    explicit LoadTimelineModel(QObject *parent = nullptr);
+    ~LoadTimelineModel() override;
+
+    // 序列管理：序列按编号递增排列，下标 0 为主序列
+    int addSeries(const QString &name, const QColor &color);
+    bool removeSeries(int seriesId);
+    QList<int> seriesIds() const;
+    qsizetype seriesCount() const { return static_cast<qsizetype>(m_series.size()); }
+    const Series &seriesAt(qsizetype index) const { return *m_series[static_cast<size_t>(index)]; }
+    const Series *findSeries(int seriesId) const;
+    QString seriesName(int seriesId) const;
+    void setSeriesName(int seriesId, const QString &name);
+    QColor seriesColor(int seriesId) const;
+    void setSeriesColor(int seriesId, const QColor &color);
+
+    // 数据接口：整批只裁剪一次、只发一次追加通知
+    void appendSample(int seriesId, const Sample &sample);
+    void appendSamples(int seriesId, const Sample *samples, qsizetype count);
+    // 列式批量追加（UTC 毫秒时间戳与负荷值），不经 QDateTime 转换
+    void appendSamples(int seriesId, const qint64 *timesMs, const double *values, qsizetype count);
+    // 整体替换：输入不要求按时间排序，存储前按时间稳定排序
+    void setSamples(int seriesId, const QVector<Sample> &samples);
+    // 复制序列的全部原始样本；绘制与统计应直接读取 findSeries()->buffer
+    QVector<Sample> samples(int seriesId) const;
+
+    // 接入信号调理：设置时清空处理级状态，已存储的样本不受影响
+    void setIngestPipeline(int seriesId, const LoadSignalPipeline &pipeline);
+    LoadSignalPipeline ingestPipeline(int seriesId) const;
+
+    // 标注：离开保留窗口后随样本裁剪一起过期。返回标注编号
+    quint64 addAnnotation(const QDateTime &timestamp, const QString &label, const QColor &color = QColor());
+    quint64 addAnnotation(const QDateTime &start, const QDateTime &end, const QString &label,
+                          const QColor &color = QColor());
+    bool removeAnnotation(quint64 id);
+    void clearAnnotations();
+    qsizetype annotationCount() const { return m_annotations.size(); }
+    const LoadAnnotationIndex &annotations() const { return m_annotations; }
+
+    // 分区阈值、滞回与去抖：决定驻留统计与分区切换判定
+    void setThresholds(double medium, double high);
+    double mediumThreshold() const { return m_mediumThreshold; }
+    double highThreshold() const { return m_highThreshold; }
+    void setZoneHysteresis(double value);
+    double zoneHysteresis() const { return m_zoneHysteresis; }
+    void setZoneDebounceMs(int ms);
+    int zoneDebounceMs() const { return m_zoneDebounceMs; }
+    // 保留窗口内各分区驻留时长（原始样本与汇总层之和）
+    LoadZoneStatistics::Dwell zoneDwell(int seriesId = PrimarySeriesId) const;
+
+    // 分层保留与内存预算（含义同控件的同名属性）
+    void setRawRetentionSeconds(int seconds);
+    int rawRetentionSeconds() const { return m_rawRetentionSeconds; }
+    void setMemoryBudgetBytes(qint64 bytes);
+    qint64 memoryBudgetBytes() const { return m_memoryBudgetBytes; }
+    void setRetentionTiers(const QVector<LoadRetentionTiers::Tier> &tiers);
+    QVector<LoadRetentionTiers::Tier> retentionTiers() const { return m_retentionTiers; }
+    // 当前数据存储占用（各序列的固定开销、样本缓冲、抽稀索引与汇总层，按已分配容量计）
+    qint64 memoryUsageBytes() const;
+    // 因内存预算在离开时间窗口之前被丢弃（未折叠进汇总层）的原始样本总数
+    quint64 evictedSampleCount() const { return m_evictedSampleCount; }
+
+    // 保留窗口：附着视图各自登记时间窗口，模型保留其中最长者（且不短于 minimumWindowSeconds）；
+    // 没有视图也没有下限时保留 60 秒
+    void setViewWindow(const QObject *view, int seconds);
+    void removeView(const QObject *view);
+    void setMinimumWindowSeconds(int seconds);
+    int minimumWindowSeconds() const { return m_minimumWindowSeconds; }
+    int timeWindowSeconds() const { return m_windowSeconds; }
+
+    // 时间源：裁剪与汇总按该时钟计算，默认为进程共享的实时时钟
+    void setClock(std::shared_ptr<LoadClock> clock);
+    std::shared_ptr<LoadClock> clock() const { return m_clock; }
+
+    // 会话录制：主序列样本同时追加写入归档文件。未写满的数据块每秒写出一次（只写新增样本），
+    // 进程异常退出时最多丢失最近约 1 秒的样本；写出只交给操作系统缓存，不强制落盘。
+    // setSamples 整体替换的历史数据不写入归档
+    bool startRecording(const QString &path);
+    void stopRecording();
+    bool isRecording() const { return m_recorder != nullptr; }
+    // 本次录制中未能写入归档的样本数（时间戳早于上一个录制样本或写入失败）
+    quint64 recordingRejectedCount() const { return m_recordingRejectedCount; }
+
+    // 跨线程数据接口：生产者句柄可在任意线程写入，帧调度器每拍取出一次
+    LoadSampleProducer createProducer(int seriesId = PrimarySeriesId, qsizetype capacity = 16384);
+    // 所有生产者队列中尚未取出的样本数
+    qsizetype queuedSampleCount() const;
+    // 队列写满而被丢弃的样本总数
+    quint64 droppedSampleCount() const;
+
+    // 接入的样本总数（含被信号调理丢弃的样本）
+    quint64 samplesIngested() const { return m_samplesIngested; }
+
+signals:
+    void seriesAdded(int seriesId);
+    void seriesRemoved(int seriesId);
+    // 序列名称或颜色变化
+    void seriesChanged(int seriesId);
+    // 新存储的样本序号范围 [firstSequence, endSequence)；其中较早的样本可能已随本批裁剪移出
+    void samplesAppended(int seriesId, qint64 firstSequence, qint64 endSequence);
+    // 序列数据被整体替换
+    void samplesReset(int seriesId);
+    // 汇总层重新配置（分层保留、内存预算或保留窗口变化）
+    void retentionChanged();
+    void annotationsChanged();
+    void thresholdsChanged(double medium, double high);
+    void zoneHysteresisChanged(double value);
+    void zoneDebounceMsChanged(int ms);
+    void rawRetentionSecondsChanged(int seconds);
+    void memoryBudgetBytesChanged(qint64 bytes);
+    void timeWindowSecondsChanged(int seconds);
+    // 序列负荷分区确认切换（已应用滞回与去抖），分区编号 0/1/2 分别为低/中/高；
+    // 在同批样本存储完成并发出 samplesAppended 之后发出，槽函数中可以安全地增删序列
+    void loadZoneChanged(int seriesId, int previousZone, int currentZone, const QDateTime &timestamp);
+    // 录制归档定时写出失败
+    void recordingError(const QString &message);
+
+private:
+    // 帧调度器每拍取出生产者队列
+    friend class LoadFrameScheduler;
+
+    // 生产者队列及其目标序列
+    struct ProducerQueue {
+        std::shared_ptr<LoadSampleQueue> queue;
+        int seriesId = PrimarySeriesId;
+    };
+
+    // 存储过程中确认的分区切换，整批完成后发出
+    struct ZoneTransition {
+        int seriesId = PrimarySeriesId;
+        int previousZone = 0;
+        int currentZone = 0;
+        qint64 timeMs = 0;
+    };
+
+    Series *findSeries(int seriesId);
+    void initSeries(Series &series);
+    static qint64 endSequence(const Series &series) { return series.buffer.firstSequence() + series.buffer.size(); }
+    // 追加完成后裁剪并通知 [beginSequence, 当前末尾) 范围
+    void finishAppend(Series &series, qint64 beginSequence);
+    // 发出整批存储期间记录的分区切换
+    void emitZoneTransitions();
+    // record 为假时不写入录制归档（setSamples 替换历史数据）
+    void storeSample(Series &series, qint64 timeMs, double value, bool record = true);
+    void pruneOutdatedSamples();
+    // 自头部移出 count 个原始样本：启用分层保留时折叠进汇总层（早于 windowStartMs 的直接丢弃）
+    void compactFront(Series &series, qsizetype count, qint64 windowStartMs);
+    bool retentionActive() const;
+    // 按当前配置、保留窗口与预算重新配置各序列的汇总层
+    void applyRetention();
+    // 占用超出预算时逐步压缩并缩减原始样本最多的序列
+    void enforceMemoryBudget();
+    void updateWindow();
+    // 取出各生产者队列；返回是否仍有活动（未挂起）的队列
+    bool drainProducerQueues();
+
+    // 曲线序列，按编号递增排列；首项为主序列
+    std::vector<std::unique_ptr<Series>> m_series;
+    int m_nextSeriesId = PrimarySeriesId + 1;
+
+    std::shared_ptr<LoadClock> m_clock = LoadClock::systemClock();
+    double m_mediumThreshold = 50.0;
+    double m_highThreshold = 80.0;
+    double m_zoneHysteresis = 0.0;
+    int m_zoneDebounceMs = 0;
+    int m_rawRetentionSeconds = 0;
+    qint64 m_memoryBudgetBytes = 0;
+    QVector<LoadRetentionTiers::Tier> m_retentionTiers = LoadRetentionTiers::defaultTiers();
+
+    // 各视图登记的时间窗口与由此得出的保留窗口
+    std::vector<std::pair<const QObject *, int>> m_viewWindows;
+    int m_minimumWindowSeconds = 0;
+    int m_windowSeconds = 60;
+
+    LoadAnnotationIndex m_annotations;
+    // 会话录制
+    std::unique_ptr<LoadSessionWriter> m_recorder;
+    QTimer m_recorderFlushTimer;
+    quint64 m_recordingRejectedCount = 0;
+    // 跨线程生产者队列（由帧调度器按节拍取出）
+    std::vector<ProducerQueue> m_producerQueues;
+    quint64 m_retiredDroppedCount = 0;
+    quint64 m_samplesIngested = 0;
+    quint64 m_evictedSampleCount = 0;
+    std::vector<ZoneTransition> m_pendingZoneTransitions;
+};
@@ -0,0 +1,374 @@
+#include "LoadTimelineRenderer.h"
+#include "LoadPathCache.h"
+#include "LoadRenderStats.h"
+#include "LoadSessionArchive.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFontMetricsF>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QtNumeric>
+
+#include <cmath>
+
+qreal LoadTimelineRenderer::uiScale(const QSizeF &size, qreal devicePixelRatio) {
+    // 以设计稿 440x260 为基准，并结合设备像素比，保证缩放后字体/画面观感一致
+    const qreal baseWidth = 440.0;
+    const qreal baseHeight = 260.0;
+    const qreal sx = size.width() / baseWidth;
+    const qreal sy = size.height() / baseHeight;
+    const qreal sizeScale = qBound<qreal>(0.85, qMin(sx, sy), 1.25);
+    return qBound<qreal>(0.9 * devicePixelRatio, sizeScale * devicePixelRatio, 1.8 * devicePixelRatio);
+}
+
+QRectF LoadTimelineRenderer::chartRect(const QRectF &bounds, qreal scale) {
+    const qreal margin = qBound<qreal>(12.0, 20.0 * scale, 32.0);
+    const qreal w = qMax<qreal>(0.0, bounds.width() - margin * 2);
+    const qreal h = qMax<qreal>(0.0, bounds.height() - margin * 2);
+    return QRectF(bounds.left() + margin, bounds.top() + margin, w, h);
+}
+
+void LoadTimelineRenderer::niceRange(double &minValue, double &maxValue, int divisions) {
+    if (!(maxValue > minValue) || divisions <= 0 || !qIsFinite(maxValue - minValue)) return;
+    const double rough = (maxValue - minValue) / divisions;
+    const double magnitude = std::pow(10.0, std::floor(std::log10(rough)));
+    // 步长至少为 2 倍粗略步长时必然能覆盖，候选序列到 20 为止
+    for (const double factor : {1.0, 2.0, 2.5, 5.0, 10.0, 20.0}) {
+        const double step = factor * magnitude;
+        const double low = std::floor(minValue / step) * step;
+        if (low + step * divisions >= maxValue) {
+            minValue = low;
+            maxValue = low + step * divisions;
+            return;
+        }
+    }
+}
+
+void LoadTimelineRenderer::setTimeAxis(TimeAxisMode mode, qint64 startMs, qint64 endMs) {
+    m_timeAxisMode = mode;
+    m_rangeStartMs = startMs;
+    m_rangeEndMs = endMs;
+}
+
+QColor LoadTimelineRenderer::zoneColor(int zone) {
+    switch (zone) {
+    case 2:
+        return QColor(198, 40, 40);
+    case 1:
+        return QColor(255, 152, 0);
+    default:
+        return QColor(56, 142, 60);
+    }
+}
+
+QColor LoadTimelineRenderer::colorForLoad(double value) const {
+    if (value >= m_highThreshold) {
+        return zoneColor(2);
+    }
+    if (value >= m_mediumThreshold) {
+        return zoneColor(1);
+    }
+    return zoneColor(0);
+}
+
+QPointF LoadTimelineRenderer::mapToChart(qint64 timeMs, double value, double nowMs, const QRectF &area) const {
+    const double loadRange = m_loadMax - m_loadMin;
+    double secondsDiff = (nowMs - timeMs) / 1000.0;
+    double ratioX = qBound(0.0, 1.0 - secondsDiff / m_timeWindowSeconds, 1.0);
+    double ratioY = (value - m_loadMin) / loadRange;
+    ratioY = qBound(0.0, ratioY, 1.0);
+
+    double x = area.left() + ratioX * area.width();
+    double y = area.bottom() - ratioY * area.height();
+    return QPointF(x, y);
+}
+
+QPainterPath LoadTimelineRenderer::buildPath(const QVector<QPointF> &points) const {
+    LoadPhaseScope scope(m_stats, LoadRenderStats::PathPhase);
+    QPainterPath path(points.first());
+    for (int i = 1; i < points.size(); ++i) {
+        appendSegment(path, points.at(i - 1), points.at(i), m_smoothingEnabled);
+    }
+    return path;
+}
+
+void LoadTimelineRenderer::appendSegment(QPainterPath &path, const QPointF &from, const QPointF &to, bool smoothing) {
+    if (!smoothing) {
+        path.lineTo(to);
+        return;
+    }
+    // 简单贝塞尔平滑：使用相邻点的中点作为控制点
+    const qreal midX = from.x() + (to.x() - from.x()) / 2;
+    path.cubicTo(QPointF(midX, from.y()), QPointF(midX, to.y()), to);
+}
+
+QByteArray LoadTimelineRenderer::backgroundKey() const {
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+    stream << m_timeWindowSeconds << m_tickIntervalSeconds << m_loadMin << m_loadMax
+           << m_mediumThreshold << m_highThreshold << m_gradientStart << m_gradientEnd
+           << m_gridVisible << int(m_timeAxisMode);
+    if (m_timeAxisMode == AbsoluteTimeAxis) {
+        stream << m_rangeStartMs << m_rangeEndMs;
+    }
+    return key;
+}
+
+void LoadTimelineRenderer::drawBackground(QPainter &painter, const QRectF &area, qreal scale) const {
+    // 绘制背景渐变
+    QLinearGradient gradient(area.topLeft(), area.bottomLeft());
+    gradient.setColorAt(0, m_gradientStart);
+    gradient.setColorAt(1, m_gradientEnd);
+    painter.fillRect(area, gradient);
+
+    drawThresholdZones(painter, area);
+    drawAxis(painter, area, scale);
+}
+
+void LoadTimelineRenderer::drawAxis(QPainter &painter, const QRectF &area, qreal scale) const {
+    LoadPhaseScope scope(m_stats, LoadRenderStats::AxisPhase);
+    painter.save();
+    QPen borderPen(QColor(120, 120, 120), 1.0 * scale);
+    painter.setPen(borderPen);
+    painter.drawRect(area);
+
+    // 网格与刻度
+    if (m_gridVisible) {
+        QPen gridPen(QColor(200, 200, 200), 1.0 * scale, Qt::DashLine);
+        painter.setPen(gridPen);
+        // 横向刻度
+        const int tickCount = qMax(2, static_cast<int>(area.width() / (50.0 * scale))); // 基于大约50px一格
+        for (int i = 1; i < tickCount; ++i) {
+            double x = area.left() + i * (area.width() / tickCount);
+            painter.drawLine(QPointF(x, area.top()), QPointF(x, area.bottom()));
+        }
+
+        // 纵向刻度
+        const int vTicks = 5;
+        for (int i = 1; i < vTicks; ++i) {
+            double y = area.top() + i * (area.height() / vTicks);
+            painter.drawLine(QPointF(area.left(), y), QPointF(area.right(), y));
+        }
+    }
+
+    // X轴时间刻度文本
+    painter.setPen(QPen(QColor(80, 80, 80), 1.0 * scale));
+    QFont tickFont = painter.font();
+    tickFont.setPointSizeF(qMax(8.0, 9.5 * scale));
+    painter.setFont(tickFont);
+
+    if (m_timeAxisMode == AbsoluteTimeAxis) {
+        // 绝对时间轴：按可见范围标注本地时刻
+        const qint64 span = m_rangeEndMs - m_rangeStartMs;
+        const QString format = span > 24 * 3600 * 1000 ? QStringLiteral("MM-dd HH:mm") : QStringLiteral("HH:mm:ss");
+        const QFontMetricsF metrics(tickFont);
+        const int labelCount = qMax(2, static_cast<int>(area.width() / (90.0 * scale)));
+        for (int i = 0; i <= labelCount; ++i) {
+            double ratio = static_cast<double>(i) / labelCount;
+            double x = area.left() + ratio * area.width();
+            painter.drawLine(QPointF(x, area.bottom()), QPointF(x, area.bottom() + 5.0 * scale));
+            const qint64 timeMs = m_rangeStartMs + qRound64(ratio * span);
+            QString label = QDateTime::fromMSecsSinceEpoch(timeMs).toString(format);
+            painter.drawText(QPointF(x - metrics.horizontalAdvance(label) / 2, area.bottom() + 18.0 * scale), label);
+        }
+    } else {
+        const int tickCount = qMax(1, m_timeWindowSeconds / m_tickIntervalSeconds);
+        for (int i = 0; i <= tickCount; ++i) {
+            double ratio = static_cast<double>(i) / tickCount;
+            double x = area.left() + (1.0 - ratio) * area.width();
+            painter.drawLine(QPointF(x, area.bottom()), QPointF(x, area.bottom() + 5.0 * scale));
+            QString label = QString::number(i * m_tickIntervalSeconds) + "s";
+            painter.drawText(QPointF(x - 10.0 * scale, area.bottom() + 18.0 * scale), label);
+        }
+    }
+
+    // Y轴刻度文本：保留足以表示刻度间距的小数位（如 2.5、0.25），最多比间距数量级多一位
+    const int vTicks = kValueDivisions;
+    const double step = (m_loadMax - m_loadMin) / vTicks;
+    int decimals = 0;
+    if (step > 0 && qIsFinite(step)) {
+        const int maxDecimals = qBound(0, int(std::ceil(-std::log10(step))) + 1, 6);
+        while (decimals < maxDecimals) {
+            const double scaled = step * std::pow(10.0, decimals);
+            if (std::abs(scaled - std::round(scaled)) < 1e-6 * scaled) break;
+            ++decimals;
+        }
+    }
+    for (int i = 0; i <= vTicks; ++i) {
+        double ratio = static_cast<double>(i) / vTicks;
+        double y = area.bottom() - ratio * area.height();
+        double value = m_loadMin + ratio * (m_loadMax - m_loadMin);
+        painter.drawLine(QPointF(area.left() - 5.0 * scale, y), QPointF(area.left(), y));
+        painter.drawText(QPointF(area.left() - 45.0 * scale, y + 4.0 * scale), QString::number(value, 'f', decimals));
+    }
+
+    painter.restore();
+}
+
+void LoadTimelineRenderer::drawThresholdZones(QPainter &painter, const QRectF &area) const {
+    LoadPhaseScope scope(m_stats, LoadRenderStats::ZonesPhase);
+    painter.save();
+
+    const double range = m_loadMax - m_loadMin;
+    if (range <= 0) {
+        painter.restore();
+        return;
+    }
+
+    auto toY = [&](double value) {
+        double ratio = (value - m_loadMin) / range;
+        ratio = qBound(0.0, ratio, 1.0);
+        return area.bottom() - ratio * area.height();
+    };
+
+    const double highY = toY(m_highThreshold);
+    const double mediumY = toY(m_mediumThreshold);
+
+    painter.fillRect(QRectF(area.left(), area.top(), area.width(), highY - area.top()), QColor(255, 235, 238, 120));
+    painter.fillRect(QRectF(area.left(), highY, area.width(), mediumY - highY), QColor(255, 248, 225, 120));
+    painter.fillRect(QRectF(area.left(), mediumY, area.width(), area.bottom() - mediumY), QColor(232, 245, 233, 120));
+
+    painter.restore();
+}
+
+void LoadTimelineRenderer::drawCurve(QPainter &painter, const QPainterPath &path, const QColor &color, qreal scale) const {
+    LoadPhaseScope scope(m_stats, LoadRenderStats::StrokePhase);
+    painter.setPen(QPen(color, 2.0 * scale));
+    painter.drawPath(path);
+}
+
+void LoadTimelineRenderer::drawZoneCurve(QPainter &painter, const QVector<QPointF> &points, const QRectF &area,
+                                         qreal scale) const {
+    const double range = m_loadMax - m_loadMin;
+    if (range <= 0 || points.size() < 2) return;
+
+    // 与 LoadPathCache 相同的切分：在阈值穿越处精确切分，同一分区的片段汇入一条路径，每个分区描边一次
+    LoadPathCache::ZonePaths zones;
+    {
+        LoadPhaseScope scope(m_stats, LoadRenderStats::PathPhase);
+        const LoadPathCache::ZoneSplitter splitter = LoadPathCache::ZoneSplitter::forThresholds(
+            area, m_loadMin, m_loadMax, m_mediumThreshold, m_highThreshold, m_smoothingEnabled);
+        for (qsizetype i = 1; i < points.size(); ++i) {
+            splitter.appendSegment(zones, points.at(i - 1), points.at(i));
+        }
+    }
+    LoadPhaseScope scope(m_stats, LoadRenderStats::StrokePhase);
+    for (int zone = 0; zone < LoadPathCache::kZoneCount; ++zone) {
+        if (zones.paths[zone].isEmpty()) continue;
+        painter.setPen(QPen(zoneColor(zone), 2.0 * scale));
+        painter.drawPath(zones.paths[zone]);
+    }
+}
+
+void LoadTimelineRenderer::drawCurrentValueLabel(QPainter &painter, const QPointF &point, double value, qreal scale) const {
+    LoadPhaseScope scope(m_stats, LoadRenderStats::OverlayPhase);
+    painter.save();
+    QString text = QString::number(value, 'f', 1);
+    QFont font = painter.font();
+    font.setBold(true);
+    font.setPointSizeF(qMax(10.0, 11.0 * scale));
+    painter.setFont(font);
+
+    QColor textColor = colorForLoad(value);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(255, 255, 255, 220));
+    QFontMetricsF metrics(font);
+    const qreal textWidth = metrics.horizontalAdvance(text) + 12.0 * scale;
+    const qreal textHeight = metrics.height() + 6.0 * scale;
+    QRectF rect(point.x() + 8.0 * scale, point.y() - textHeight, textWidth, textHeight);
+    painter.drawRoundedRect(rect, 4.0 * scale, 4.0 * scale);
+
+    painter.setPen(QPen(textColor, 1.0 * scale));
+    painter.drawText(rect.adjusted(4, 0, -4, 0), Qt::AlignVCenter | Qt::AlignLeft, text);
+
+    painter.setPen(QPen(textColor, 2.0 * scale));
+    painter.drawEllipse(point, 4.0 * scale, 4.0 * scale);
+
+    painter.restore();
+}
+
+void LoadTimelineRenderer::drawArchiveCurve(QPainter &painter, const QRectF &area, const LoadSessionArchive &archive,
+                                            const QColor &color, qreal scale) const {
+    const double loadRange = m_loadMax - m_loadMin;
+    const double span = double(m_rangeEndMs - m_rangeStartMs);
+    if (loadRange <= 0 || span <= 0 || archive.sampleCount() == 0) return;
+
+    auto toX = [&](qint64 timeMs) { return area.left() + (timeMs - m_rangeStartMs) / span * area.width(); };
+    auto toY = [&](double value) {
+        const double ratio = qBound(0.0, (value - m_loadMin) / loadRange, 1.0);
+        return area.bottom() - ratio * area.height();
+    };
+
+    const int columns = qMax(1, static_cast<int>(area.width()));
+    const qint64 first = archive.lowerBound(m_rangeStartMs);
+    const qint64 last = archive.lowerBound(m_rangeEndMs);
+
+    QVector<QPointF> points;
+    QPainterPath path;
+    {
+        LoadPhaseScope mapScope(m_stats, LoadRenderStats::MapPhase);
+        if (last - first <= qint64(columns) * 2) {
+            // 样本稀疏：直接绘制原始样本，并带上范围两侧各一个样本保持连续
+            const qint64 from = qMax<qint64>(0, first - 1);
+            const qint64 to = qMin(archive.sampleCount(), last + 1);
+            points.reserve(to - from);
+            for (qint64 i = from; i < to; ++i) {
+                points.append(QPointF(toX(archive.timeAt(i)), toY(archive.valueAt(i))));
+            }
+        } else {
+            // 样本密集：按像素列取极值包络，只访问可见范围所需的页面
+            archive.envelope(m_rangeStartMs, m_rangeEndMs, columns, m_envelopeMin, m_envelopeMax);
+            points.reserve(columns * 2);
+            for (int column = 0; column < columns; ++column) {
+                if (qIsNaN(m_envelopeMin.at(column))) continue;
+                const double x = area.left() + (column + 0.5) * area.width() / columns;
+                const bool rising = (column % 2) == 0;
+                points.append(QPointF(x, toY(rising ? m_envelopeMin.at(column) : m_envelopeMax.at(column))));
+                points.append(QPointF(x, toY(rising ? m_envelopeMax.at(column) : m_envelopeMin.at(column))));
+            }
+        }
+    }
+    if (points.size() < 2) return;
+
+    if (last - first <= qint64(columns) * 2) {
+        path = buildPath(points);
+    } else {
+        // 包络折线不做平滑，避免贝塞尔控制点越过极值
+        path.moveTo(points.constFirst());
+        for (qsizetype i = 1; i < points.size(); ++i) {
+            path.lineTo(points.at(i));
+        }
+    }
+
+    painter.save();
+    painter.setClipRect(area);
+    drawCurve(painter, path, color, scale);
+    painter.restore();
+}
+
+void LoadTimelineRenderer::renderArchive(QPainter &painter, const QRectF &bounds, const LoadSessionArchive &archive,
+                                         const QColor &color, qreal devicePixelRatio) {
+    const qint64 startMs = archive.startTime();
+    setTimeAxis(AbsoluteTimeAxis, startMs, qMax(archive.endTime(), startMs + 1000));
+
+    const qreal scale = uiScale(bounds.size(), devicePixelRatio);
+    const QRectF area = chartRect(bounds, scale);
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    drawBackground(painter, area, scale);
+    drawArchiveCurve(painter, area, archive, color, scale);
+
+    // 末尾标签：会话最后一个样本
+    const double loadRange = m_loadMax - m_loadMin;
+    if (m_currentValueLabelVisible && archive.sampleCount() >= 2 && loadRange > 0) {
+        const qint64 lastIndex = archive.sampleCount() - 1;
+        const double value = archive.valueAt(lastIndex);
+        const double ratioX = double(archive.timeAt(lastIndex) - m_rangeStartMs) / (m_rangeEndMs - m_rangeStartMs);
+        const double ratioY = qBound(0.0, (value - m_loadMin) / loadRange, 1.0);
+        const QPointF point(area.left() + qBound(0.0, ratioX, 1.0) * area.width(),
+                            area.bottom() - ratioY * area.height());
+        drawCurrentValueLabel(painter, point, value, scale);
+    }
+    painter.restore();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QByteArray>
+#include <QColor>
+#include <QPainterPath>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include <QtGlobal>
+
+class QPainter;
+class LoadSessionArchive;
+struct LoadRenderStats;
+
+// 负荷时间轴绘制器：承载控件的外观属性与全部绘制逻辑，可绘制到任意 QPaintDevice（QImage、QPdfWriter 等）。
+// 不依赖 QWidget，成员只在绘制调用内读取；每个线程持有各自的副本即可并行绘制。
+class LoadTimelineRenderer {
+public:
+    // 横轴标注方式：相对当前时刻的秒数，或归档的绝对本地时刻
+    enum TimeAxisMode {
+        RelativeTimeAxis = 0,
+        AbsoluteTimeAxis = 1
+    };
+
+    // 布局：以设计稿 440x260 为基准结合设备像素比计算缩放，边距随缩放变化
+    static qreal uiScale(const QSizeF &size, qreal devicePixelRatio);
+    static QRectF chartRect(const QRectF &bounds, qreal scale);
+
+    // 纵轴刻度等分数
+    static constexpr int kValueDivisions = 4;
+    // 把 [minValue, maxValue] 扩展为以 1/2/2.5/5 × 10^n 为步长、端点落在步长整数倍上的范围，
+    // 等分 divisions 份后每个刻度都是整齐的数值；范围无效时不做修改
+    static void niceRange(double &minValue, double &maxValue, int divisions = kValueDivisions);
+
+    // 外观属性（与控件同名属性一致）
+    int timeWindowSeconds() const { return m_timeWindowSeconds; }
+    int tickIntervalSeconds() const { return m_tickIntervalSeconds; }
+    double loadMin() const { return m_loadMin; }
+    double loadMax() const { return m_loadMax; }
+    double highThreshold() const { return m_highThreshold; }
+    double mediumThreshold() const { return m_mediumThreshold; }
+    QColor gradientStart() const { return m_gradientStart; }
+    QColor gradientEnd() const { return m_gradientEnd; }
+    bool gridVisible() const { return m_gridVisible; }
+    bool smoothingEnabled() const { return m_smoothingEnabled; }
+    bool currentValueLabelVisible() const { return m_currentValueLabelVisible; }
+
+    void setTimeWindowSeconds(int seconds) { m_timeWindowSeconds = seconds; }
+    void setTickIntervalSeconds(int seconds) { m_tickIntervalSeconds = seconds; }
+    void setLoadMin(double value) { m_loadMin = value; }
+    void setLoadMax(double value) { m_loadMax = value; }
+    void setHighThreshold(double value) { m_highThreshold = value; }
+    void setMediumThreshold(double value) { m_mediumThreshold = value; }
+    void setGradientStart(const QColor &color) { m_gradientStart = color; }
+    void setGradientEnd(const QColor &color) { m_gradientEnd = color; }
+    void setGridVisible(bool visible) { m_gridVisible = visible; }
+    void setSmoothingEnabled(bool enabled) { m_smoothingEnabled = enabled; }
+    void setCurrentValueLabelVisible(bool visible) { m_currentValueLabelVisible = visible; }
+
+    // 绝对时间轴的可见范围（UTC 毫秒）
+    TimeAxisMode timeAxisMode() const { return m_timeAxisMode; }
+    void setTimeAxis(TimeAxisMode mode, qint64 startMs = 0, qint64 endMs = 0);
+    qint64 rangeStartMs() const { return m_rangeStartMs; }
+    qint64 rangeEndMs() const { return m_rangeEndMs; }
+
+    // 阶段计时输出，为空时不计时
+    void setStats(LoadRenderStats *stats) { m_stats = stats; }
+    LoadRenderStats *stats() const { return m_stats; }
+
+    // 分区颜色：0 正常、1 中负荷、2 高负荷
+    static QColor zoneColor(int zone);
+    QColor colorForLoad(double value) const;
+    // 相对时间轴：nowMs 对应图表右缘
+    QPointF mapToChart(qint64 timeMs, double value, double nowMs, const QRectF &area) const;
+    QPainterPath buildPath(const QVector<QPointF> &points) const;
+    // 追加一段曲线：平滑时以相邻点的中点为控制点作三次贝塞尔
+    static void appendSegment(QPainterPath &path, const QPointF &from, const QPointF &to, bool smoothing);
+
+    // 背景缓存键：编码影响 drawBackground 输出的全部属性（不含尺寸与字体），相同则背景相同
+    QByteArray backgroundKey() const;
+    // 背景渐变 + 阈值分区 + 坐标轴
+    void drawBackground(QPainter &painter, const QRectF &area, qreal scale) const;
+    void drawThresholdZones(QPainter &painter, const QRectF &area) const;
+    void drawAxis(QPainter &painter, const QRectF &area, qreal scale) const;
+    void drawCurve(QPainter &painter, const QPainterPath &path, const QColor &color, qreal scale) const;
+    // 分区着色描边：折线（图表坐标）在阈值穿越处精确切分，各分区的片段汇成一条路径并以分区颜色描边一次。
+    // 切分与 LoadPathCache 相同，滚动贴图与异步绘制的分区颜色与缓存路径模式一致
+    void drawZoneCurve(QPainter &painter, const QVector<QPointF> &points, const QRectF &area, qreal scale) const;
+    void drawCurrentValueLabel(QPainter &painter, const QPointF &point, double value, qreal scale) const;
+    // 绘制归档在绝对时间范围内的曲线：稀疏时用原始样本，密集时用每像素列极值包络
+    void drawArchiveCurve(QPainter &painter, const QRectF &area, const LoadSessionArchive &archive,
+                          const QColor &color, qreal scale) const;
+
+    // 报表绘制：以归档全程为时间范围，在 bounds 内绘制完整图表
+    void renderArchive(QPainter &painter, const QRectF &bounds, const LoadSessionArchive &archive,
+                       const QColor &color, qreal devicePixelRatio = 1.0);
+
+private:
+    int m_timeWindowSeconds = 60;
+    int m_tickIntervalSeconds = 10;
+    double m_loadMin = 0.0;
+    double m_loadMax = 100.0;
+    double m_highThreshold = 80.0;
+    double m_mediumThreshold = 50.0;
+    QColor m_gradientStart = QColor(240, 248, 255);
+    QColor m_gradientEnd = QColor(210, 228, 255);
+    bool m_gridVisible = true;
+    bool m_smoothingEnabled = true;
+    bool m_currentValueLabelVisible = true;
+
+    TimeAxisMode m_timeAxisMode = RelativeTimeAxis;
+    qint64 m_rangeStartMs = 0;
+    qint64 m_rangeEndMs = 0;
+
+    LoadRenderStats *m_stats = nullptr;
+
+    // 包络计算的复用缓冲（随副本各自持有，不跨线程共享）
+    mutable QVector<double> m_envelopeMin;
+    mutable QVector<double> m_envelopeMax;
+};
@@ -1,42 +1,433 @@
 #include "LoadTimelineWidget.h"
+#include "LoadBackgroundCache.h"
+#include "LoadFrameScheduler.h"
+#include "LoadMappingKernel.h"
+#include "LoadPathCache.h"
+#include "LoadRenderStats.h"
 
 #include <QBrush>
+#include <QDataStream>
 #include <QDebug>
+#include <QEvent>
+#include <QLineF>
+#include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPainter>
 #include <QFontMetricsF>
+#include <QStringList>
+#include <QTimeZone>
+#include <QWheelEvent>
+#include <QtNumeric>
 #include <QtMath>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+// 未指定颜色的标注
+const QColor kDefaultAnnotationColor(94, 53, 177);
+// 自动量程过渡中两次调整显示范围的最小间隔：每次调整都会重绘背景并重建路径缓存
+constexpr qint64 kAutoScaleStepMs = 100;
+} // namespace
+
 LoadTimelineWidget::LoadTimelineWidget(QWidget *parent)
     : QFrame(parent) {
     setMinimumHeight(180);
     setFrameStyle(QFrame::Box | QFrame::Plain);
     setLineWidth(1);
+
+    m_ownedModel = std::make_unique<LoadTimelineModel>();
+    m_ownedModel->setThresholds(m_renderer.mediumThreshold(), m_renderer.highThreshold());
+    attachModel(m_ownedModel.get());
+
+    m_lastPaintTimer.start();
+    setMouseTracking(m_hoverInspectionEnabled);
+
+    // 运行统计：启用统计或调试叠加层时按周期发布
+    connect(&m_statsTimer, &QTimer::timeout, this, &LoadTimelineWidget::publishRenderStats);
 }
 
-void LoadTimelineWidget::appendSample(const Sample &sample) {
-    m_samples.append(sample);
-    pruneOutdatedSamples();
+LoadTimelineWidget::~LoadTimelineWidget() {
+    // 先断开模型信号：私有模型在控件之后析构，外部模型可能在控件析构途中继续发信号
+    detachModel();
+    LoadFrameScheduler::release(this);
+}
+
+void LoadTimelineWidget::setModel(LoadTimelineModel *model) {
+    if (model ? model == m_model : m_ownedModel && m_model == m_ownedModel.get()) return;
+    detachModel();
+    if (model) {
+        m_ownedModel.reset();
+    } else {
+        m_ownedModel = std::make_unique<LoadTimelineModel>();
+        m_ownedModel->setClock(m_clock);
+        m_ownedModel->setThresholds(m_renderer.mediumThreshold(), m_renderer.highThreshold());
+        model = m_ownedModel.get();
+    }
+    attachModel(model);
+    emit modelChanged(model);
+    emit seriesListChanged();
     update();
 }
 
+void LoadTimelineWidget::attachModel(LoadTimelineModel *model) {
+    m_model = model;
+    m_model->setViewWindow(this, m_renderer.timeWindowSeconds());
+
+    // 新数据只请求下一帧；整体替换、序列增删与汇总层重配置使曲线缓存失效
+    connect(model, &LoadTimelineModel::samplesAppended, this, [this]() { scheduleRepaint(); });
+    connect(model, &LoadTimelineModel::annotationsChanged, this, [this]() { scheduleRepaint(); });
+    connect(model, &LoadTimelineModel::samplesReset, this, [this]() {
+        invalidateCurveLayer();
+        update();
+    });
+    connect(model, &LoadTimelineModel::retentionChanged, this, [this]() {
+        invalidateCurveLayer();
+        update();
+    });
+    auto seriesListUpdated = [this]() {
+        syncSeriesViews();
+        invalidateCurveLayer();
+        emit seriesListChanged();
+        update();
+    };
+    connect(model, &LoadTimelineModel::seriesAdded, this, seriesListUpdated);
+    connect(model, &LoadTimelineModel::seriesRemoved, this, seriesListUpdated);
+    connect(model, &LoadTimelineModel::seriesChanged, this, seriesListUpdated);
+    connect(model, &LoadTimelineModel::thresholdsChanged, this, [this](double medium, double high) {
+        // 阈值由模型统一决定：其他视图修改后本控件的分区背景随之更新
+        if (medium == m_renderer.mediumThreshold() && high == m_renderer.highThreshold()) return;
+        m_renderer.setMediumThreshold(medium);
+        m_renderer.setHighThreshold(high);
+        emit thresholdChanged(medium, high);
+        invalidateBackground();
+        if (m_zoneColoredCurve) invalidateCurveLayer();
+        update();
+    });
+    connect(model, &LoadTimelineModel::zoneHysteresisChanged, this, &LoadTimelineWidget::zoneHysteresisChanged);
+    connect(model, &LoadTimelineModel::zoneDebounceMsChanged, this, &LoadTimelineWidget::zoneDebounceMsChanged);
+    connect(model, &LoadTimelineModel::rawRetentionSecondsChanged, this,
+            &LoadTimelineWidget::rawRetentionSecondsChanged);
+    connect(model, &LoadTimelineModel::memoryBudgetBytesChanged, this, &LoadTimelineWidget::memoryBudgetBytesChanged);
+    connect(model, &LoadTimelineModel::recordingError, this, &LoadTimelineWidget::recordingError);
+    connect(model, &LoadTimelineModel::loadZoneChanged, this,
+            [this](int seriesId, int previous, int current, const QDateTime &timestamp) {
+                emit loadZoneChanged(seriesId, static_cast<LoadZone>(previous), static_cast<LoadZone>(current),
+                                     timestamp);
+            });
+    connect(model, &QObject::destroyed, this, [this]() {
+        // 外部模型先于控件销毁：换用新的私有模型
+        m_model = nullptr;
+        m_seriesViews.clear();
+        setModel(nullptr);
+    });
+
+    syncSeriesViews();
+    const double medium = model->mediumThreshold();
+    const double high = model->highThreshold();
+    if (medium != m_renderer.mediumThreshold() || high != m_renderer.highThreshold()) {
+        m_renderer.setMediumThreshold(medium);
+        m_renderer.setHighThreshold(high);
+        emit thresholdChanged(medium, high);
+        invalidateBackground();
+    }
+    m_hover.visible = false;
+    m_autoScaleHasTarget = false;
+    invalidateCurveLayer();
+}
+
+void LoadTimelineWidget::detachModel() {
+    if (!m_model) return;
+    disconnect(m_model, nullptr, this, nullptr);
+    m_model->removeView(this);
+    m_model = nullptr;
+    m_seriesViews.clear();
+}
+
+void LoadTimelineWidget::syncSeriesViews() {
+    // 两侧均按编号递增排列，归并即可
+    std::vector<std::unique_ptr<SeriesView>> views;
+    views.reserve(static_cast<size_t>(m_model->seriesCount()));
+    size_t existing = 0;
+    for (qsizetype i = 0; i < m_model->seriesCount(); ++i) {
+        const int id = m_model->seriesAt(i).id;
+        while (existing < m_seriesViews.size() && m_seriesViews[existing]->id < id) ++existing;
+        if (existing < m_seriesViews.size() && m_seriesViews[existing]->id == id) {
+            views.push_back(std::move(m_seriesViews[existing++]));
+        } else {
+            auto view = std::make_unique<SeriesView>();
+            view->id = id;
+            views.push_back(std::move(view));
+        }
+    }
+    m_seriesViews.swap(views);
+}
+
+void LoadTimelineWidget::appendSample(const Sample &sample) {
+    m_model->appendSample(PrimarySeriesId, sample);
+}
+
+void LoadTimelineWidget::appendSamples(const Sample *samples, qsizetype count) {
+    m_model->appendSamples(PrimarySeriesId, samples, count);
+}
+
+void LoadTimelineWidget::appendSamples(const QVector<Sample> &samples) {
+    m_model->appendSamples(PrimarySeriesId, samples.constData(), samples.size());
+}
+
 void LoadTimelineWidget::setSamples(const QVector<Sample> &samples) {
-    m_samples = samples;
-    pruneOutdatedSamples();
+    m_model->setSamples(PrimarySeriesId, samples);
+}
+
+QVector<LoadTimelineWidget::Sample> LoadTimelineWidget::samples() const {
+    return m_model->samples(PrimarySeriesId);
+}
+
+int LoadTimelineWidget::addSeries(const QString &name, const QColor &color) {
+    return m_model->addSeries(name, color);
+}
+
+bool LoadTimelineWidget::removeSeries(int seriesId) {
+    return m_model->removeSeries(seriesId);
+}
+
+QList<int> LoadTimelineWidget::seriesIds() const {
+    return m_model->seriesIds();
+}
+
+QString LoadTimelineWidget::seriesName(int seriesId) const {
+    return m_model->seriesName(seriesId);
+}
+
+void LoadTimelineWidget::setSeriesName(int seriesId, const QString &name) {
+    m_model->setSeriesName(seriesId, name);
+}
+
+QColor LoadTimelineWidget::seriesColor(int seriesId) const {
+    return m_model->seriesColor(seriesId);
+}
+
+void LoadTimelineWidget::setSeriesColor(int seriesId, const QColor &color) {
+    m_model->setSeriesColor(seriesId, color);
+}
+
+void LoadTimelineWidget::appendSeriesSample(int seriesId, const Sample &sample) {
+    m_model->appendSample(seriesId, sample);
+}
+
+void LoadTimelineWidget::appendSeriesSamples(int seriesId, const Sample *samples, qsizetype count) {
+    m_model->appendSamples(seriesId, samples, count);
+}
+
+void LoadTimelineWidget::appendSeriesSamples(int seriesId, const qint64 *timesMs, const double *values,
+                                             qsizetype count) {
+    m_model->appendSamples(seriesId, timesMs, values, count);
+}
+
+void LoadTimelineWidget::setSeriesSamples(int seriesId, const QVector<Sample> &samples) {
+    m_model->setSamples(seriesId, samples);
+}
+
+QVector<LoadTimelineWidget::Sample> LoadTimelineWidget::seriesSamples(int seriesId) const {
+    return m_model->samples(seriesId);
+}
+
+void LoadTimelineWidget::setIngestPipeline(int seriesId, const LoadSignalPipeline &pipeline) {
+    m_model->setIngestPipeline(seriesId, pipeline);
+}
+
+LoadSignalPipeline LoadTimelineWidget::ingestPipeline(int seriesId) const {
+    return m_model->ingestPipeline(seriesId);
+}
+
+quint64 LoadTimelineWidget::addAnnotation(const QDateTime &timestamp, const QString &label, const QColor &color) {
+    return m_model->addAnnotation(timestamp, label, color);
+}
+
+quint64 LoadTimelineWidget::addAnnotation(const QDateTime &start, const QDateTime &end, const QString &label,
+                                          const QColor &color) {
+    return m_model->addAnnotation(start, end, label, color);
+}
+
+bool LoadTimelineWidget::removeAnnotation(quint64 id) {
+    return m_model->removeAnnotation(id);
+}
+
+void LoadTimelineWidget::clearAnnotations() {
+    m_model->clearAnnotations();
+}
+
+void LoadTimelineWidget::setAnnotationsVisible(bool visible) {
+    if (visible == m_annotationsVisible) return;
+    m_annotationsVisible = visible;
+    emit annotationsVisibleChanged(visible);
+    update();
+}
+
+void LoadTimelineWidget::drawAnnotations(QPainter &painter, qreal scale) {
+    const LoadAnnotationIndex &annotations = m_model->annotations();
+    if (!m_annotationsVisible || annotations.isEmpty()) return;
+    const QRectF area = chartRect();
+    const qint64 now = m_frameNowMs;
+    const qint64 windowMs = qint64(m_renderer.timeWindowSeconds()) * 1000;
+    if (area.width() <= 0 || windowMs <= 0) return;
+    const double pxPerMs = area.width() / double(windowMs);
+
+    QVector<const LoadAnnotationIndex::Annotation *> &visible = m_visibleAnnotations;
+    visible.resize(0);
+    annotations.query(now - windowMs, now, visible);
+    if (visible.isEmpty()) return;
+
+    // 按颜色分批：区间合并为一次填充，点事件合并为一次描边；同一像素列上的同色点事件只画一次
+    for (AnnotationBatch &batch : m_annotationBatches) {
+        batch.spans.resize(0);
+        batch.marks.resize(0);
+        batch.hasMark = false;
+    }
+    qsizetype batchCount = 0;
+    auto batchFor = [&](const QColor &color) -> AnnotationBatch & {
+        for (qsizetype i = 0; i < batchCount; ++i) {
+            if (m_annotationBatches[i].color == color) return m_annotationBatches[i];
+        }
+        if (batchCount == m_annotationBatches.size()) m_annotationBatches.append(AnnotationBatch());
+        AnnotationBatch &batch = m_annotationBatches[batchCount++];
+        batch.color = color;
+        return batch;
+    };
+    auto toX = [&](qint64 timeMs) { return area.right() - double(now - timeMs) * pxPerMs; };
+
+    for (const LoadAnnotationIndex::Annotation *annotation : visible) {
+        AnnotationBatch &batch = batchFor(annotation->color.isValid() ? annotation->color : kDefaultAnnotationColor);
+        const double startX = qMax(area.left(), toX(annotation->startMs));
+        if (annotation->isPoint()) {
+            const int column = qFloor(startX);
+            if (batch.hasMark && batch.lastMarkColumn == column) continue;
+            batch.hasMark = true;
+            batch.lastMarkColumn = column;
+            batch.marks.append(QLineF(startX, area.top(), startX, area.bottom()));
+        } else {
+            const double endX = qMin(area.right(), toX(annotation->endMs));
+            batch.spans.append(QRectF(startX, area.top(), qMax(1.0, endX - startX), area.height()));
+        }
+    }
+
+    painter.save();
+    painter.setClipRect(area);
+    for (qsizetype i = 0; i < batchCount; ++i) {
+        const AnnotationBatch &batch = m_annotationBatches.at(i);
+        if (!batch.spans.isEmpty()) {
+            QColor fill = batch.color;
+            fill.setAlpha(48);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(fill);
+            painter.drawRects(batch.spans);
+        }
+        if (!batch.marks.isEmpty()) {
+            painter.setPen(QPen(batch.color, 1.5 * scale));
+            painter.drawLines(batch.marks);
+        }
+    }
+
+    // 标签沿图表顶部自左向右排布，与前一个标签重叠时跳过，绘制数量只与图表宽度相关
+    QFont labelFont = painter.font();
+    labelFont.setPointSizeF(qMax(7.5, 8.5 * scale));
+    painter.setFont(labelFont);
+    const QFontMetricsF metrics(labelFont);
+    const qreal gap = 4.0 * scale;
+    qreal nextFree = area.left();
+    for (const LoadAnnotationIndex::Annotation *annotation : visible) {
+        if (annotation->label.isEmpty()) continue;
+        const qreal x = qMax(area.left(), toX(annotation->startMs)) + gap;
+        if (x < nextFree || x >= area.right()) continue;
+        const QColor color = annotation->color.isValid() ? annotation->color : kDefaultAnnotationColor;
+        painter.setPen(color.darker(130));
+        painter.drawText(QPointF(x, area.top() + gap + metrics.ascent()), annotation->label);
+        nextFree = x + metrics.horizontalAdvance(annotation->label) + gap;
+    }
+    painter.restore();
+}
+
+LoadZoneStatistics::Dwell LoadTimelineWidget::zoneDwell(int seriesId) const {
+    return m_model->zoneDwell(seriesId);
+}
+
+void LoadTimelineWidget::setRetentionTiers(const QVector<LoadRetentionTiers::Tier> &tiers) {
+    m_model->setRetentionTiers(tiers);
+}
+
+qint64 LoadTimelineWidget::memoryUsageBytes() const {
+    return m_model->memoryUsageBytes();
+}
+
+bool LoadTimelineWidget::openHistoryArchive(const QString &path) {
+    auto archive = std::make_unique<LoadSessionArchive>();
+    if (!archive->open(path)) return false;
+
+    m_historyArchive = std::move(archive);
+    setHistoryRangeMs(m_historyArchive->startTime(), qMax(m_historyArchive->endTime(), m_historyArchive->startTime() + 1000));
+    return true;
+}
+
+void LoadTimelineWidget::closeHistoryArchive() {
+    if (!m_historyArchive) return;
+    m_historyArchive.reset();
+    invalidateBackground();
     update();
 }
 
+void LoadTimelineWidget::setHistoryRange(const QDateTime &start, const QDateTime &end) {
+    setHistoryRangeMs(start.toMSecsSinceEpoch(), end.toMSecsSinceEpoch());
+}
+
+QDateTime LoadTimelineWidget::historyRangeStart() const {
+    return QDateTime::fromMSecsSinceEpoch(m_historyStartMs, QTimeZone::UTC);
+}
+
+QDateTime LoadTimelineWidget::historyRangeEnd() const {
+    return QDateTime::fromMSecsSinceEpoch(m_historyEndMs, QTimeZone::UTC);
+}
+
+bool LoadTimelineWidget::startRecording(const QString &path) {
+    return m_model->startRecording(path);
+}
+
+void LoadTimelineWidget::stopRecording() {
+    m_model->stopRecording();
+}
+
+LoadSampleProducer LoadTimelineWidget::createProducer(qsizetype capacity) {
+    return createSeriesProducer(PrimarySeriesId, capacity);
+}
+
+LoadSampleProducer LoadTimelineWidget::createSeriesProducer(int seriesId, qsizetype capacity) {
+    return m_model->createProducer(seriesId, capacity);
+}
+
+qsizetype LoadTimelineWidget::queuedSampleCount() const {
+    return m_model->queuedSampleCount();
+}
+
+quint64 LoadTimelineWidget::droppedSampleCount() const {
+    return m_model->droppedSampleCount();
+}
+
 void LoadTimelineWidget::setTimeWindowSeconds(int seconds) {
-    if (seconds <= 0 || seconds == m_timeWindowSeconds) return;
-    m_timeWindowSeconds = seconds;
-    pruneOutdatedSamples();
+    if (seconds <= 0 || seconds == m_renderer.timeWindowSeconds()) return;
+    m_renderer.setTimeWindowSeconds(seconds);
+    // 模型的保留窗口取所有视图中最长者，变化时重新配置汇总层并裁剪
+    m_model->setViewWindow(this, seconds);
     emit timeWindowSecondsChanged(seconds);
+    invalidateBackground();
+    invalidateCurveLayer();
     update();
 }
 
 void LoadTimelineWidget::setTickIntervalSeconds(int seconds) {
-    if (seconds <= 0 || seconds == m_tickIntervalSeconds) return;
-    m_tickIntervalSeconds = seconds;
+    if (seconds <= 0 || seconds == m_renderer.tickIntervalSeconds()) return;
+    m_renderer.setTickIntervalSeconds(seconds);
     emit tickIntervalSecondsChanged(seconds);
+    invalidateBackground();
     update();
 }
 
@@ -44,6 +435,8 @@ void LoadTimelineWidget::setLoadMin(double value) {
     if (qFuzzyCompare(value, m_loadMin)) return;
     m_loadMin = value;
     emit loadRangeChanged(m_loadMin, m_loadMax);
+    // 自动量程时只作为无数据时的默认范围
+    if (!m_autoScaleEnabled) setDisplayedLoadRange(m_loadMin, m_loadMax);
     update();
 }
 
@@ -51,278 +444,1315 @@ void LoadTimelineWidget::setLoadMax(double value) {
     if (qFuzzyCompare(value, m_loadMax)) return;
     m_loadMax = value;
     emit loadRangeChanged(m_loadMin, m_loadMax);
+    if (!m_autoScaleEnabled) setDisplayedLoadRange(m_loadMin, m_loadMax);
+    update();
+}
+
+void LoadTimelineWidget::setAutoScaleEnabled(bool enabled) {
+    if (enabled == m_autoScaleEnabled) return;
+    m_autoScaleEnabled = enabled;
+    m_autoScaleHasTarget = false;
+    if (!enabled) setDisplayedLoadRange(m_loadMin, m_loadMax);
+    emit autoScaleEnabledChanged(enabled);
+    update();
+}
+
+void LoadTimelineWidget::setAutoScalePadding(double fraction) {
+    fraction = qMax(0.0, fraction);
+    if (qFuzzyCompare(fraction, m_autoScalePadding)) return;
+    m_autoScalePadding = fraction;
+    emit autoScalePaddingChanged(fraction);
+    update();
+}
+
+void LoadTimelineWidget::setAutoScaleNiceRange(bool enabled) {
+    if (enabled == m_autoScaleNiceRange) return;
+    m_autoScaleNiceRange = enabled;
+    emit autoScaleNiceRangeChanged(enabled);
     update();
 }
 
+void LoadTimelineWidget::setAutoScaleAnimationMs(int ms) {
+    if (ms < 0 || ms == m_autoScaleAnimationMs) return;
+    m_autoScaleAnimationMs = ms;
+    emit autoScaleAnimationMsChanged(ms);
+}
+
+void LoadTimelineWidget::setDisplayedLoadRange(double minValue, double maxValue) {
+    if (minValue == m_renderer.loadMin() && maxValue == m_renderer.loadMax()) return;
+    m_renderer.setLoadMin(minValue);
+    m_renderer.setLoadMax(maxValue);
+    invalidateBackground();
+    invalidateCurveLayer();
+    emit displayedLoadRangeChanged(minValue, maxValue);
+}
+
+bool LoadTimelineWidget::autoScaleTarget(double &minValue, double &maxValue) {
+    bool found = false;
+    double low = std::numeric_limits<double>::infinity();
+    double high = -std::numeric_limits<double>::infinity();
+    auto include = [&](double minimum, double maximum) {
+        low = qMin(low, minimum);
+        high = qMax(high, maximum);
+        found = true;
+    };
+
+    // 与更宽的视图共用模型时，模型保留的数据长于本控件的时间窗口：只统计窗口内的部分
+    const bool shared = sharedWindow();
+    const qint64 windowStart = m_frameNowMs - qint64(m_renderer.timeWindowSeconds()) * 1000;
+    for (qsizetype index = 0; index < m_model->seriesCount(); ++index) {
+        const SeriesData &series = m_model->seriesAt(index);
+        SeriesView &view = *m_seriesViews[static_cast<size_t>(index)];
+        if (!shared) {
+            if (!series.extrema.isEmpty()) include(series.extrema.min(), series.extrema.max());
+        } else {
+            double minimum = 0.0;
+            double maximum = 0.0;
+            if (visibleExtrema(series, windowStart, minimum, maximum)) include(minimum, maximum);
+        }
+        const LoadRetentionTiers &tiers = series.tiers;
+        if (!tiers.isEnabled() || tiers.isEmpty()) continue;
+        if (shared) {
+            // 汇总桶数有上限，直接扫描窗口内的桶
+            for (int t = 0; t < tiers.tierCount(); ++t) {
+                for (qsizetype i = tiers.lowerBound(t, windowStart); i < tiers.bucketCount(t); ++i) {
+                    include(tiers.bucketAt(t, i).minValue, tiers.bucketAt(t, i).maxValue);
+                }
+            }
+            continue;
+        }
+        // 已完成的汇总桶只在层级结构变化时重扫（桶数有上限）；仍在接收样本的最新桶每帧单独计入
+        if (view.tierExtremaRevision != tiers.revision()) {
+            view.tierExtremaRevision = tiers.revision();
+            view.tierExtremaValid = false;
+            for (int t = 0; t < tiers.tierCount(); ++t) {
+                const qsizetype count = tiers.bucketCount(t) - (t == 0 && tiers.bucketCount(0) > 0 ? 1 : 0);
+                for (qsizetype i = 0; i < count; ++i) {
+                    const LoadRetentionTiers::Bucket &bucket = tiers.bucketAt(t, i);
+                    if (!view.tierExtremaValid) {
+                        view.tierExtremaMin = bucket.minValue;
+                        view.tierExtremaMax = bucket.maxValue;
+                        view.tierExtremaValid = true;
+                        continue;
+                    }
+                    view.tierExtremaMin = qMin(view.tierExtremaMin, bucket.minValue);
+                    view.tierExtremaMax = qMax(view.tierExtremaMax, bucket.maxValue);
+                }
+            }
+        }
+        if (view.tierExtremaValid) {
+            include(view.tierExtremaMin, view.tierExtremaMax);
+        }
+        if (tiers.bucketCount(0) > 0) {
+            const LoadRetentionTiers::Bucket &open = tiers.bucketAt(0, tiers.bucketCount(0) - 1);
+            include(open.minValue, open.maxValue);
+        }
+    }
+    if (!found || !qIsFinite(low) || !qIsFinite(high)) return false;
+
+    // 恒定信号没有跨度：以数值量级的 10%（至少 1）作为跨度居中显示
+    if (high - low <= 0) {
+        const double half = qMax(std::abs(high) * 0.05, 0.5);
+        low -= half;
+        high += half;
+    }
+    const double padding = (high - low) * m_autoScalePadding;
+    low -= padding;
+    high += padding;
+    if (m_autoScaleNiceRange) {
+        LoadTimelineRenderer::niceRange(low, high);
+    }
+    minValue = low;
+    maxValue = high;
+    return true;
+}
+
+bool LoadTimelineWidget::visibleExtrema(const SeriesData &series, qint64 windowStartMs, double &minValue,
+                                        double &maxValue) const {
+    const LoadSampleBuffer &buffer = series.buffer;
+    const qsizetype first = buffer.lowerBound(windowStartMs);
+    if (first >= buffer.size()) return false;
+
+    // 与绘制相同的抽稀层级：整桶取抽稀索引的极值，首个不完整的桶逐样本比较，开销与像素宽度同量级
+    minValue = std::numeric_limits<double>::infinity();
+    maxValue = -std::numeric_limits<double>::infinity();
+    auto include = [&](double minimum, double maximum) {
+        if (minimum < minValue) minValue = minimum;
+        if (maximum > maxValue) maxValue = maximum;
+    };
+    const int level = LoadDecimationPyramid::levelFor(buffer.size() - first, chartRect().width());
+    qsizetype index = first;
+    if (level > 0) {
+        const int shift = LoadDecimationPyramid::bucketShift(level);
+        const qint64 firstBucket = ((buffer.firstSequence() + first) >> shift) + 1;
+        const qsizetype rawEnd = qMin<qsizetype>(buffer.size(), (firstBucket << shift) - buffer.firstSequence());
+        for (; index < rawEnd; ++index) {
+            include(buffer.valueAt(index), buffer.valueAt(index));
+        }
+        const LoadDecimationPyramid &pyramid = series.pyramid;
+        for (qint64 b = qMax(firstBucket, pyramid.firstBucketIndex(level)) - pyramid.firstBucketIndex(level);
+             b < pyramid.bucketCount(level); ++b) {
+            const LoadDecimationPyramid::Bucket &bucket = pyramid.bucketAt(level, b);
+            include(bucket.minValue, bucket.maxValue);
+        }
+        index = buffer.size();
+    }
+    for (; index < buffer.size(); ++index) {
+        include(buffer.valueAt(index), buffer.valueAt(index));
+    }
+    return minValue <= maxValue;
+}
+
+void LoadTimelineWidget::updateAutoScale() {
+    double low = 0.0;
+    double high = 0.0;
+    if (!autoScaleTarget(low, high)) return;
+
+    const qint64 now = m_frameNowMs;
+    if (!m_autoScaleHasTarget || low != m_autoScaleTargetMin || high != m_autoScaleTargetMax) {
+        // 目标变化：从当前显示范围重新开始过渡
+        m_autoScaleHasTarget = true;
+        m_autoScaleFromMin = m_renderer.loadMin();
+        m_autoScaleFromMax = m_renderer.loadMax();
+        m_autoScaleTargetMin = low;
+        m_autoScaleTargetMax = high;
+        m_autoScaleStartMs = now;
+    }
+    if (m_renderer.loadMin() == low && m_renderer.loadMax() == high) return;
+
+    const double progress = m_autoScaleAnimationMs > 0
+        ? qBound(0.0, double(now - m_autoScaleStartMs) / m_autoScaleAnimationMs, 1.0)
+        : 1.0;
+    // 限速：过渡中的调整至少间隔 kAutoScaleStepMs，数据持续刷新极值时背景也不会逐帧重绘
+    if (progress < 1.0 && now - m_autoScaleLastStepMs < kAutoScaleStepMs) {
+        scheduleRepaint();
+        return;
+    }
+    m_autoScaleLastStepMs = now;
+    // 缓出：先快后慢，接近目标时变化平缓
+    const double eased = 1.0 - (1.0 - progress) * (1.0 - progress);
+    setDisplayedLoadRange(m_autoScaleFromMin + (low - m_autoScaleFromMin) * eased,
+                          m_autoScaleFromMax + (high - m_autoScaleFromMax) * eased);
+    if (progress < 1.0) scheduleRepaint();
+}
+
 void LoadTimelineWidget::setHighThreshold(double value) {
-    if (qFuzzyCompare(value, m_highThreshold)) return;
-    m_highThreshold = value;
-    emit thresholdChanged(m_mediumThreshold, m_highThreshold);
+    if (qFuzzyCompare(value, m_renderer.highThreshold())) return;
+    m_renderer.setHighThreshold(value);
+    m_model->setThresholds(m_renderer.mediumThreshold(), m_renderer.highThreshold());
+    emit thresholdChanged(m_renderer.mediumThreshold(), m_renderer.highThreshold());
+    invalidateBackground();
+    // 分区着色的曲线贴图按阈值着色
+    if (m_zoneColoredCurve) invalidateCurveLayer();
     update();
 }
 
 void LoadTimelineWidget::setMediumThreshold(double value) {
-    if (qFuzzyCompare(value, m_mediumThreshold)) return;
-    m_mediumThreshold = value;
-    emit thresholdChanged(m_mediumThreshold, m_highThreshold);
+    if (qFuzzyCompare(value, m_renderer.mediumThreshold())) return;
+    m_renderer.setMediumThreshold(value);
+    m_model->setThresholds(m_renderer.mediumThreshold(), m_renderer.highThreshold());
+    emit thresholdChanged(m_renderer.mediumThreshold(), m_renderer.highThreshold());
+    invalidateBackground();
+    // 分区着色的曲线贴图按阈值着色
+    if (m_zoneColoredCurve) invalidateCurveLayer();
     update();
 }
 
 void LoadTimelineWidget::setGradientStart(const QColor &color) {
-    if (color == m_gradientStart) return;
-    m_gradientStart = color;
+    if (color == m_renderer.gradientStart()) return;
+    m_renderer.setGradientStart(color);
     emit gradientChanged();
+    invalidateBackground();
     update();
 }
 
 void LoadTimelineWidget::setGradientEnd(const QColor &color) {
-    if (color == m_gradientEnd) return;
-    m_gradientEnd = color;
+    if (color == m_renderer.gradientEnd()) return;
+    m_renderer.setGradientEnd(color);
     emit gradientChanged();
+    invalidateBackground();
     update();
 }
 
 void LoadTimelineWidget::setGridVisible(bool visible) {
-    if (visible == m_gridVisible) return;
-    m_gridVisible = visible;
+    if (visible == m_renderer.gridVisible()) return;
+    m_renderer.setGridVisible(visible);
     emit gridVisibilityChanged(visible);
+    invalidateBackground();
     update();
 }
 
 void LoadTimelineWidget::setSmoothingEnabled(bool enabled) {
-    if (enabled == m_smoothingEnabled) return;
-    m_smoothingEnabled = enabled;
+    if (enabled == m_renderer.smoothingEnabled()) return;
+    m_renderer.setSmoothingEnabled(enabled);
     emit smoothingChanged(enabled);
+    invalidateCurveLayer();
+    update();
+}
+
+void LoadTimelineWidget::setZoneColoredCurve(bool enabled) {
+    if (enabled == m_zoneColoredCurve) return;
+    m_zoneColoredCurve = enabled;
+    emit zoneColoredCurveChanged(enabled);
+    // 滚动贴图与异步绘制的曲线层按旧颜色栅格化，需整体重绘
+    invalidateCurveLayer();
     update();
 }
 
 void LoadTimelineWidget::setCurrentValueLabelVisible(bool visible) {
-    if (visible == m_currentValueLabelVisible) return;
-    m_currentValueLabelVisible = visible;
+    if (visible == m_renderer.currentValueLabelVisible()) return;
+    m_renderer.setCurrentValueLabelVisible(visible);
+    m_asyncDirty = true;
     emit labelVisibilityChanged(visible);
     update();
 }
 
-void LoadTimelineWidget::paintEvent(QPaintEvent *event) {
-    Q_UNUSED(event);
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
+void LoadTimelineWidget::setScrollBlitEnabled(bool enabled) {
+    if (enabled == m_scrollBlitEnabled) return;
+    m_scrollBlitEnabled = enabled;
+    m_curveLayer = QPixmap();
+    invalidateCurveLayer();
+    emit scrollBlitChanged(enabled);
+    update();
+}
 
-    const qreal scale = uiScale();
+void LoadTimelineWidget::setAsyncRenderingEnabled(bool enabled) {
+    if (enabled == asyncRenderingEnabled()) return;
+    if (enabled) {
+        // 工作线程只投递重绘请求；控件析构前会等待在途任务结束
+        m_asyncRenderer = std::make_unique<LoadAsyncRenderer>(
+            [this]() { QMetaObject::invokeMethod(this, [this]() { update(); }, Qt::QueuedConnection); });
+        m_asyncDirty = true;
+    } else {
+        m_asyncRenderer.reset();
+    }
+    emit asyncRenderingChanged(enabled);
+    update();
+}
 
-    QRectF area = chartRect();
+void LoadTimelineWidget::setMaxFrameRate(int fps) {
+    if (fps < 0 || fps == m_maxFrameRate) return;
+    m_maxFrameRate = fps;
+    emit maxFrameRateChanged(fps);
+}
 
-    // 绘制背景渐变
-    QLinearGradient gradient(area.topLeft(), area.bottomLeft());
-    gradient.setColorAt(0, m_gradientStart);
-    gradient.setColorAt(1, m_gradientEnd);
-    painter.fillRect(area, gradient);
+void LoadTimelineWidget::setZoneHysteresis(double value) {
+    m_model->setZoneHysteresis(value);
+}
 
-    drawThresholdZones(painter, area);
-    drawAxis(painter, area, scale);
+void LoadTimelineWidget::setZoneDebounceMs(int ms) {
+    m_model->setZoneDebounceMs(ms);
+}
 
-    QVector<QPointF> points = mapSamplesToPoints();
-    if (points.size() < 2) return;
+void LoadTimelineWidget::setRawRetentionSeconds(int seconds) {
+    m_model->setRawRetentionSeconds(seconds);
+}
 
-    QPainterPath path = buildPath(points);
-    painter.setPen(QPen(QColor(0, 96, 180), 2.0 * scale));
-    painter.drawPath(path);
+void LoadTimelineWidget::setMemoryBudgetBytes(qint64 bytes) {
+    m_model->setMemoryBudgetBytes(bytes);
+}
 
-    // 末尾标签
-    if (m_currentValueLabelVisible) {
-        const QPointF &last = points.constLast();
-        double lastValue = m_samples.constLast().loadValue;
-        drawCurrentValueLabel(painter, last, lastValue, scale);
-    }
+void LoadTimelineWidget::setHistoryMode(bool enabled) {
+    if (enabled == m_historyMode) return;
+    m_historyMode = enabled;
+    m_panning = false;
+    invalidateBackground();
+    emit historyModeChanged(enabled);
+    update();
 }
 
-QRectF LoadTimelineWidget::chartRect() const {
-    const qreal margin = scaledMargin();
-    const qreal w = qMax<qreal>(0.0, width() - margin * 2);
-    const qreal h = qMax<qreal>(0.0, height() - margin * 2);
-    return QRectF(margin, margin, w, h);
+bool LoadTimelineWidget::historyActive() const {
+    return m_historyMode && m_historyArchive;
 }
 
-qreal LoadTimelineWidget::uiScale() const {
-    // 以设计稿 440x260 为基准，并结合设备像素比，保证缩放后字体/画面观感一致
-    const qreal baseWidth = 440.0;
-    const qreal baseHeight = 260.0;
-    const qreal sx = width() / baseWidth;
-    const qreal sy = height() / baseHeight;
-    const qreal sizeScale = qBound<qreal>(0.85, qMin(sx, sy), 1.25);
-    const qreal dprScale = devicePixelRatioF();
-    return qBound<qreal>(0.9 * dprScale, sizeScale * dprScale, 1.8 * dprScale);
+void LoadTimelineWidget::setHistoryRangeMs(qint64 startMs, qint64 endMs) {
+    if (endMs <= startMs) return;
+    if (startMs == m_historyStartMs && endMs == m_historyEndMs) return;
+    m_historyStartMs = startMs;
+    m_historyEndMs = endMs;
+    invalidateBackground();
+    emit historyRangeChanged(historyRangeStart(), historyRangeEnd());
+    update();
 }
 
-qreal LoadTimelineWidget::scaledMargin() const {
-    const qreal scale = uiScale();
-    return qBound<qreal>(12.0, 20.0 * scale, 32.0);
+void LoadTimelineWidget::setInstrumentationEnabled(bool enabled) {
+    if (enabled == m_instrumentationEnabled) return;
+    m_instrumentationEnabled = enabled;
+    updateStatsTimer();
+    emit instrumentationChanged(enabled);
 }
 
-void LoadTimelineWidget::pruneOutdatedSamples() {
-    if (m_samples.isEmpty()) return;
-    const QDateTime bound = QDateTime::currentDateTimeUtc().addSecs(-m_timeWindowSeconds);
+void LoadTimelineWidget::setDebugOverlayVisible(bool visible) {
+    if (visible == m_debugOverlayVisible) return;
+    m_debugOverlayVisible = visible;
+    updateStatsTimer();
+    emit debugOverlayChanged(visible);
+    update();
+}
 
-    while (!m_samples.isEmpty() && m_samples.first().timestamp < bound) {
-        m_samples.pop_front();
+LoadRenderStats LoadTimelineWidget::renderStats() const {
+    LoadRenderStats stats = m_renderStats;
+    stats.framesSkipped = m_repaintsCoalesced;
+    stats.framesDropped = m_asyncRenderer ? m_asyncRenderer->droppedFrames() : 0;
+    stats.samplesIngested = m_model->samplesIngested();
+    stats.bufferedSamples = 0;
+    stats.bufferCapacity = 0;
+    for (qsizetype i = 0; i < m_model->seriesCount(); ++i) {
+        stats.bufferedSamples += m_model->seriesAt(i).buffer.size();
+        stats.bufferCapacity += m_model->seriesAt(i).buffer.capacity();
     }
+    return stats;
 }
 
-QPainterPath LoadTimelineWidget::buildPath(const QVector<QPointF> &points) const {
-    QPainterPath path(points.first());
-    if (!m_smoothingEnabled) {
-        for (int i = 1; i < points.size(); ++i) {
-            path.lineTo(points.at(i));
+void LoadTimelineWidget::setClock(std::shared_ptr<LoadClock> clock) {
+    if (!clock) clock = LoadClock::systemClock();
+    if (clock == m_clock) return;
+    m_clock = std::move(clock);
+    // 裁剪与汇总按同一时钟进行；共用模型的其他视图同样改用该时钟裁剪
+    m_model->setClock(m_clock);
+    invalidateCurveLayer();
+    update();
+}
+
+LoadRenderStats *LoadTimelineWidget::statsSink() const {
+    return (m_instrumentationEnabled || m_debugOverlayVisible) ? &m_renderStats : nullptr;
+}
+
+void LoadTimelineWidget::updateStatsTimer() {
+    if (m_instrumentationEnabled || m_debugOverlayVisible) {
+        if (!m_statsTimer.isActive()) {
+            m_statsClock.start();
+            m_statsFramesMark = m_renderStats.framesRendered;
+            m_statsSamplesMark = m_model->samplesIngested();
+            m_statsTimer.start(1000);
         }
-        return path;
+    } else {
+        m_statsTimer.stop();
     }
+}
 
-    // 简单贝塞尔平滑：使用相邻点的中点作为控制点
-    for (int i = 1; i < points.size(); ++i) {
-        QPointF prev = points.at(i - 1);
-        QPointF current = points.at(i);
-        QPointF c1(prev.x() + (current.x() - prev.x()) / 2, prev.y());
-        QPointF c2(prev.x() + (current.x() - prev.x()) / 2, current.y());
-        path.cubicTo(c1, c2, current);
+void LoadTimelineWidget::publishRenderStats() {
+    // 按统计周期计算帧率与接入速率
+    const qint64 elapsedMs = qMax<qint64>(1, m_statsClock.restart());
+    m_renderStats.framesPerSecond = (m_renderStats.framesRendered - m_statsFramesMark) * 1000.0 / elapsedMs;
+    const quint64 ingested = m_model->samplesIngested();
+    m_renderStats.samplesPerSecond = (ingested - m_statsSamplesMark) * 1000.0 / elapsedMs;
+    m_statsFramesMark = m_renderStats.framesRendered;
+    m_statsSamplesMark = ingested;
+
+    const LoadRenderStats stats = renderStats();
+    if (m_instrumentationEnabled) {
+        emit renderStatsUpdated(stats);
+    }
+    if (m_debugOverlayVisible) {
+        update();
     }
-    return path;
 }
 
-QVector<QPointF> LoadTimelineWidget::mapSamplesToPoints() const {
-    QVector<QPointF> mapped;
-    if (m_samples.isEmpty()) return mapped;
+void LoadTimelineWidget::drawDebugOverlay(QPainter &painter, qreal scale) {
+    const LoadRenderStats stats = renderStats();
+    QStringList lines;
+    lines << QStringLiteral("fps %1  skipped %2  dropped %3")
+                 .arg(stats.framesPerSecond, 0, 'f', 1).arg(stats.framesSkipped).arg(stats.framesDropped);
+    lines << QStringLiteral("ingest %1/s  buffer %2/%3")
+                 .arg(stats.samplesPerSecond, 0, 'f', 0).arg(stats.bufferedSamples).arg(stats.bufferCapacity);
+    for (int i = 0; i < LoadRenderStats::PhaseCount; ++i) {
+        const auto phase = static_cast<LoadRenderStats::Phase>(i);
+        lines << QStringLiteral("%1 %2 ms").arg(QLatin1String(LoadRenderStats::phaseName(phase)), -8)
+                     .arg(stats.averagePhaseNs[i] / 1e6, 0, 'f', 3);
+    }
 
-    QRectF area = chartRect();
-    const double loadRange = m_loadMax - m_loadMin;
-    if (loadRange <= 0) return mapped;
+    painter.save();
+    QFont font = painter.font();
+    font.setFamily(QStringLiteral("monospace"));
+    font.setStyleHint(QFont::Monospace);
+    font.setPointSizeF(qMax(7.0, 8.0 * scale));
+    painter.setFont(font);
+    const QFontMetricsF metrics(font);
 
-    const QDateTime now = QDateTime::currentDateTimeUtc();
+    qreal textWidth = 0.0;
+    for (const QString &line : lines) {
+        textWidth = qMax(textWidth, metrics.horizontalAdvance(line));
+    }
+    const QRectF area = chartRect();
+    const QRectF box(area.left() + 6.0 * scale, area.top() + 6.0 * scale,
+                     textWidth + 12.0 * scale, metrics.height() * lines.size() + 8.0 * scale);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 160));
+    painter.drawRect(box);
+    painter.setPen(Qt::white);
+    qreal y = box.top() + 4.0 * scale + metrics.ascent();
+    for (const QString &line : lines) {
+        painter.drawText(QPointF(box.left() + 6.0 * scale, y), line);
+        y += metrics.height();
+    }
+    painter.restore();
+}
 
-    for (const Sample &sample : m_samples) {
-        double secondsDiff = sample.timestamp.msecsTo(now) / 1000.0;
-        double ratioX = qBound(0.0, 1.0 - secondsDiff / m_timeWindowSeconds, 1.0);
-        double ratioY = (sample.loadValue - m_loadMin) / loadRange;
-        ratioY = qBound(0.0, ratioY, 1.0);
+void LoadTimelineWidget::scheduleRepaint() {
+    if (m_maxFrameRate <= 0) {
+        update();
+        return;
+    }
+    if (m_framePending) {
+        ++m_repaintsCoalesced;
+        return;
+    }
+    // 由共享节拍统一派发：没有新数据的控件不会被重绘
+    LoadFrameScheduler::instance()->requestFrame(this);
+}
 
-        double x = area.left() + ratioX * area.width();
-        double y = area.bottom() - ratioY * area.height();
-        mapped.append(QPointF(x, y));
+bool LoadTimelineWidget::frameDue(double tickIntervalMs) const {
+    if (m_maxFrameRate <= 0) return true;
+    return m_lastPaintTimer.elapsed() + tickIntervalMs / 2 >= 1000.0 / m_maxFrameRate;
+}
+
+void LoadTimelineWidget::paintEvent(QPaintEvent *event) {
+    // 只有悬停叠加层变化的局部重绘：屏幕其余部分仍是上一帧，从帧缓存补回脏区域后重画叠加层
+    const qreal dpr = devicePixelRatioF();
+    const bool hoverFrameUsable = !m_hoverFrame.isNull() && m_hoverFrame.size() == size() * dpr
+        && qFuzzyCompare(m_hoverFrame.devicePixelRatio(), dpr);
+    if (hoverFrameUsable && !QRegion(rect()).subtracted(event->region()).isEmpty()) {
+        QPainter painter(this);
+        for (const QRect &dirty : event->region()) {
+            painter.drawPixmap(dirty, m_hoverFrame, QRectF(QPointF(dirty.topLeft()) * dpr, QSizeF(dirty.size()) * dpr));
+        }
+        if (m_hover.visible) drawHoverOverlay(painter);
+        if (m_debugOverlayVisible) drawDebugOverlay(painter, uiScale());
+        return;
     }
 
-    return mapped;
+    m_lastPaintTimer.restart();
+    // 序列增删通知之前就被同步重绘（如模型信号处理中调用 repaint()）时先补齐绘制状态
+    if (static_cast<qsizetype>(m_seriesViews.size()) != m_model->seriesCount()) syncSeriesViews();
+    LoadRenderStats *stats = statsSink();
+    m_renderer.setStats(stats);
+    QElapsedTimer frameTimer;
+    if (stats) frameTimer.start();
+
+    // 本帧所有绘制共用同一时刻
+    m_frameNowMs = m_clock->nowMs();
+    if (m_autoScaleEnabled && !historyActive()) {
+        updateAutoScale();
+    }
+    QPainter painter(this);
+    if (m_hover.visible) {
+        // 检视期间先画到帧缓存再贴到屏幕；时间推进后重新查找光标处的样本
+        if (!hoverFrameUsable) {
+            m_hoverFrame = QPixmap(size() * dpr);
+            m_hoverFrame.setDevicePixelRatio(dpr);
+        }
+        {
+            QPainter framePainter(&m_hoverFrame);
+            paintContent(framePainter);
+        }
+        painter.drawPixmap(0, 0, m_hoverFrame);
+        m_hover.visible = !historyActive() && locateHover();
+        if (m_hover.visible) drawHoverOverlay(painter);
+    } else {
+        if (!m_hoverFrame.isNull()) m_hoverFrame = QPixmap();
+        paintContent(painter);
+    }
+
+    if (stats) {
+        stats->addPhase(LoadRenderStats::FramePhase, frameTimer.nsecsElapsed());
+        stats->commitFrame();
+    }
+    if (m_debugOverlayVisible) {
+        drawDebugOverlay(painter, uiScale());
+    }
 }
 
-QColor LoadTimelineWidget::colorForLoad(double value) const {
-    if (value >= m_highThreshold) {
-        return QColor(198, 40, 40);
+void LoadTimelineWidget::paintContent(QPainter &painter) {
+    const qreal scale = uiScale();
+
+    // 静态背景层（渐变、阈值分区、网格与刻度）只在失效时重绘
+    const qreal dpr = devicePixelRatioF();
+    if (m_backgroundDirty || !m_background || m_background->size() != size() * dpr
+        || !qFuzzyCompare(m_background->devicePixelRatio(), dpr)) {
+        acquireBackground(dpr, scale);
+    }
+    painter.drawPixmap(0, 0, *m_background);
+
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    if (historyActive()) {
+        paintHistoryCurve(painter, scale);
+        return;
     }
-    if (value >= m_mediumThreshold) {
-        return QColor(255, 152, 0);
+
+    // 标注层位于背景与曲线之间，随时间推进平移，每帧绘制
+    drawAnnotations(painter, scale);
+
+    if (m_asyncRenderer) {
+        paintAsyncCurves(painter, dpr, scale);
+        return;
     }
-    return QColor(56, 142, 60);
+
+    if (m_scrollBlitEnabled) {
+        paintScrollBlitCurve(painter, dpr, scale);
+        return;
+    }
+
+    paintCachedCurves(painter, scale);
 }
 
-void LoadTimelineWidget::drawAxis(QPainter &painter, const QRectF &area, qreal scale) {
+void LoadTimelineWidget::paintCachedCurves(QPainter &painter, qreal scale) {
+    const QRectF area = chartRect();
+    if (m_renderer.loadMax() - m_renderer.loadMin() <= 0) return;
+
+    // 共享一次背景与坐标轴；各序列的缓存路径按时间相对坐标保存，只需平移到当前时刻
+    const qint64 now = m_frameNowMs;
+    const qint64 windowStart = now - qint64(m_renderer.timeWindowSeconds()) * 1000;
+    LoadPathCache::Geometry geometry;
+    geometry.area = area;
+    geometry.windowSeconds = m_renderer.timeWindowSeconds();
+    geometry.loadMin = m_renderer.loadMin();
+    geometry.loadMax = m_renderer.loadMax();
+    geometry.smoothing = m_renderer.smoothingEnabled();
+    geometry.zoneColoring = m_zoneColoredCurve;
+    geometry.mediumThreshold = m_renderer.mediumThreshold();
+    geometry.highThreshold = m_renderer.highThreshold();
+
     painter.save();
-    QPen borderPen(QColor(120, 120, 120), 1.0 * scale);
-    painter.setPen(borderPen);
-    painter.drawRect(area);
-
-    // 网格与刻度
-    if (m_gridVisible) {
-        QPen gridPen(QColor(200, 200, 200), 1.0 * scale, Qt::DashLine);
-        painter.setPen(gridPen);
-        // 横向刻度
-        const int tickCount = qMax(2, static_cast<int>(area.width() / (50.0 * scale))); // 基于大约50px一格
-        for (int i = 1; i < tickCount; ++i) {
-            double x = area.left() + i * (area.width() / tickCount);
-            painter.drawLine(QPointF(x, area.top()), QPointF(x, area.bottom()));
-        }
-
-        // 纵向刻度
-        const int vTicks = 5;
-        for (int i = 1; i < vTicks; ++i) {
-            double y = area.top() + i * (area.height() / vTicks);
-            painter.drawLine(QPointF(area.left(), y), QPointF(area.right(), y));
-        }
-    }
-
-    // X轴时间刻度文本
-    painter.setPen(QPen(QColor(80, 80, 80), 1.0 * scale));
-    QFont tickFont = painter.font();
-    tickFont.setPointSizeF(qMax(8.0, 9.5 * scale));
-    painter.setFont(tickFont);
-
-    const int tickCount = qMax(1, m_timeWindowSeconds / m_tickIntervalSeconds);
-    for (int i = 0; i <= tickCount; ++i) {
-        double ratio = static_cast<double>(i) / tickCount;
-        double x = area.left() + (1.0 - ratio) * area.width();
-        painter.drawLine(QPointF(x, area.bottom()), QPointF(x, area.bottom() + 5.0 * scale));
-        QString label = QString::number(i * m_tickIntervalSeconds) + "s";
-        painter.drawText(QPointF(x - 10.0 * scale, area.bottom() + 18.0 * scale), label);
-    }
-
-    // Y轴刻度文本
-    const int vTicks = 4;
-    for (int i = 0; i <= vTicks; ++i) {
-        double ratio = static_cast<double>(i) / vTicks;
-        double y = area.bottom() - ratio * area.height();
-        double value = m_loadMin + ratio * (m_loadMax - m_loadMin);
-        painter.drawLine(QPointF(area.left() - 5.0 * scale, y), QPointF(area.left(), y));
-        painter.drawText(QPointF(area.left() - 45.0 * scale, y + 4.0 * scale), QString::number(value, 'f', 0));
-    }
+    // 横向按图表区域裁剪（窗口外的路径段），纵向留出线宽避免裁掉贴边的描边
+    const qreal penWidth = 2.0 * scale;
+    const QRectF clip = area.adjusted(0, -penWidth, 0, penWidth);
+    painter.setClipRect(clip);
+    auto strokeCache = [&](const LoadPathCache &cache, const QColor &color) {
+        const double offset = cache.offsetX(now);
+        painter.translate(offset, 0);
+        // 每个分区一支画笔、一次描边（单色模式只有分区 0）
+        const int zones = m_zoneColoredCurve ? LoadPathCache::kZoneCount : 1;
+        for (int zone = 0; zone < zones; ++zone) {
+            const QPainterPath &path = cache.strokePath(zone);
+            if (path.isEmpty()) continue;
+            painter.setPen(QPen(m_zoneColoredCurve ? LoadTimelineRenderer::zoneColor(zone) : color, penWidth));
+            painter.drawPath(path);
+        }
+        painter.translate(-offset, 0);
+    };
+    const double pxPerMs = area.width() / (m_renderer.timeWindowSeconds() * 1000.0);
+    for (qsizetype index = 0; index < m_model->seriesCount(); ++index) {
+        const SeriesData &series = m_model->seriesAt(index);
+        SeriesView &view = *m_seriesViews[static_cast<size_t>(index)];
+        // 汇总层只在原始样本未覆盖窗口起点时可见
+        const bool hasTiers = series.tiers.isEnabled() && !series.tiers.isEmpty()
+            && (series.buffer.isEmpty() || series.buffer.firstTime() > windowStart);
+        if (series.buffer.size() < 2 && !hasTiers) continue;
+        geometry.dataGeneration = series.dataGeneration;
+
+        if (hasTiers) {
+            // 汇总段画在最早原始样本左侧，原始路径缓存中已折叠的旧点被裁掉，两者在分界处相接
+            const double rawStartX = series.buffer.isEmpty()
+                ? area.right()
+                : area.right() - (now - series.buffer.firstTime()) * pxPerMs;
+            {
+                LoadPhaseScope pathScope(statsSink(), LoadRenderStats::PathPhase);
+                syncTierPaths(series, view, geometry);
+            }
+            LoadPhaseScope strokeScope(statsSink(), LoadRenderStats::StrokePhase);
+            painter.setClipRect(QRectF(QPointF(clip.left(), clip.top()), QPointF(rawStartX, clip.bottom())));
+            strokeCache(view.tierPath, series.color);
+            strokeCache(view.tierBridge, series.color);
+            painter.setClipRect(QRectF(QPointF(rawStartX, clip.top()), clip.bottomRight()));
+        }
 
+        if (series.buffer.size() >= 2) {
+            LoadPathCache &cache = view.pathCache;
+            {
+                LoadPhaseScope pathScope(statsSink(), LoadRenderStats::PathPhase);
+                cache.sync(series.buffer, series.pyramid, geometry, windowStart);
+            }
+            LoadPhaseScope strokeScope(statsSink(), LoadRenderStats::StrokePhase);
+            strokeCache(cache, series.color);
+        }
+        if (hasTiers) painter.setClipRect(clip);
+    }
     painter.restore();
+
+    // 末尾标签（主序列），绘制在所有曲线之上
+    const LoadSampleBuffer &primary = primarySeries().buffer;
+    if (m_renderer.currentValueLabelVisible() && primary.size() >= 2) {
+        const QPointF last = m_renderer.mapToChart(primary.lastTime(), primary.lastValue(), now, area);
+        m_renderer.drawCurrentValueLabel(painter, last, primary.lastValue(), scale);
+    }
+}
+
+void LoadTimelineWidget::paintScrollBlitCurve(QPainter &painter, qreal dpr, qreal scale) {
+    if (m_renderer.loadMax() - m_renderer.loadMin() <= 0) return;
+
+    const QRectF area = chartRect();
+    const qint64 now = m_frameNowMs;
+    const double devicePxPerMs = area.width() * dpr / (m_renderer.timeWindowSeconds() * 1000.0);
+
+    bool fullRedraw = m_curveLayerDirty || devicePxPerMs <= 0
+        || m_curveLayer.size() != size() * dpr
+        || !qFuzzyCompare(m_curveLayer.devicePixelRatio(), dpr);
+
+    // 平移上一帧：整数设备像素位移，余数保留在参考时间中避免漂移
+    const QRect deviceArea(qCeil(area.left() * dpr), qCeil(area.top() * dpr),
+                           qFloor(area.width() * dpr), qFloor(area.height() * dpr));
+    int shift = 0;
+    if (!fullRedraw) {
+        shift = qFloor((now - m_curveLayerTime) * devicePxPerMs);
+        if (shift >= deviceArea.width()) fullRedraw = true;
+    }
+
+    // 历史被改写（样本被替换、接续点已被裁剪或新样本早于已绘制的最后时刻）时需要整体重绘
+    for (qsizetype index = 0; !fullRedraw && index < m_model->seriesCount(); ++index) {
+        const SeriesView &view = *m_seriesViews[static_cast<size_t>(index)];
+        const LoadSampleBuffer &buffer = m_model->seriesAt(index).buffer;
+        const qint64 nextSequence = buffer.firstSequence() + buffer.size();
+        if (view.layerNextSequence > nextSequence
+            || (nextSequence > view.layerNextSequence && view.layerNextSequence <= buffer.firstSequence())) {
+            fullRedraw = true;
+            break;
+        }
+        for (qint64 seq = view.layerNextSequence; seq < nextSequence; ++seq) {
+            if (buffer.timeAt(seq - buffer.firstSequence()) < view.layerLastTime) {
+                fullRedraw = true;
+                break;
+            }
+        }
+    }
+
+    if (fullRedraw) {
+        if (m_curveLayer.size() != size() * dpr) {
+            m_curveLayer = QPixmap(size() * dpr);
+        }
+        m_curveLayer.setDevicePixelRatio(dpr);
+        m_curveLayer.fill(Qt::transparent);
+        m_curveLayerTime = now;
+
+        QPainter layerPainter(&m_curveLayer);
+        layerPainter.setRenderHint(QPainter::Antialiasing, true);
+        layerPainter.setClipRect(area);
+        for (qsizetype index = 0; index < m_model->seriesCount(); ++index) {
+            const SeriesData &series = m_model->seriesAt(index);
+            const QVector<QPointF> &points =
+                mapSamplesToPoints(series, *m_seriesViews[static_cast<size_t>(index)], m_curveLayerTime);
+            if (points.size() < 2) continue;
+            strokeLayerCurve(layerPainter, points, series.color, area, scale);
+        }
+        m_curveLayerDirty = false;
+    } else {
+        if (shift > 0) {
+            m_curveLayer.scroll(-shift, 0, deviceArea);
+            m_curveLayerTime += shift / devicePxPerMs;
+
+            QPainter clearPainter(&m_curveLayer);
+            clearPainter.setCompositionMode(QPainter::CompositionMode_Source);
+            const QRectF exposed(QPointF(deviceArea.right() + 1 - shift, deviceArea.top()) / dpr,
+                                 QSizeF(shift, deviceArea.height()) / dpr);
+            clearPainter.fillRect(exposed, Qt::transparent);
+        }
+
+        // 仅绘制新样本对应的右侧片段，从上一帧最后绘制的样本接续
+        QPainter layerPainter(&m_curveLayer);
+        layerPainter.setRenderHint(QPainter::Antialiasing, true);
+        layerPainter.setClipRect(area);
+        QVector<QPointF> points;
+        for (qsizetype index = 0; index < m_model->seriesCount(); ++index) {
+            const SeriesData &series = m_model->seriesAt(index);
+            const SeriesView &view = *m_seriesViews[static_cast<size_t>(index)];
+            const LoadSampleBuffer &buffer = series.buffer;
+            const qint64 nextSequence = buffer.firstSequence() + buffer.size();
+            if (nextSequence <= view.layerNextSequence) continue;
+
+            points.clear();
+            for (qint64 seq = view.layerNextSequence - 1; seq < nextSequence; ++seq) {
+                const qsizetype sampleIndex = seq - buffer.firstSequence();
+                points.append(m_renderer.mapToChart(buffer.timeAt(sampleIndex), buffer.valueAt(sampleIndex),
+                                                    m_curveLayerTime, area));
+            }
+            strokeLayerCurve(layerPainter, points, series.color, area, scale);
+        }
+    }
+
+    for (qsizetype index = 0; index < m_model->seriesCount(); ++index) {
+        const LoadSampleBuffer &buffer = m_model->seriesAt(index).buffer;
+        SeriesView &view = *m_seriesViews[static_cast<size_t>(index)];
+        view.layerNextSequence = buffer.firstSequence() + buffer.size();
+        if (!buffer.isEmpty()) {
+            view.layerLastTime = buffer.lastTime();
+        }
+    }
+
+    {
+        LoadPhaseScope strokeScope(statsSink(), LoadRenderStats::StrokePhase);
+        painter.drawPixmap(0, 0, m_curveLayer);
+    }
+
+    // 当前值标签每帧实时绘制，不进入缓存
+    const LoadSampleBuffer &primary = primarySeries().buffer;
+    if (m_renderer.currentValueLabelVisible() && primary.size() >= 2) {
+        const QPointF last = m_renderer.mapToChart(primary.lastTime(), primary.lastValue(), m_curveLayerTime, area);
+        m_renderer.drawCurrentValueLabel(painter, last, primary.lastValue(), scale);
+    }
+}
+
+void LoadTimelineWidget::strokeLayerCurve(QPainter &painter, const QVector<QPointF> &points, const QColor &color,
+                                          const QRectF &area, qreal scale) const {
+    // 贴图中的曲线逐段追加；分区着色与缓存路径模式相同，在阈值穿越处切分后按分区描边
+    if (m_zoneColoredCurve) {
+        m_renderer.drawZoneCurve(painter, points, area, scale);
+    } else {
+        m_renderer.drawCurve(painter, m_renderer.buildPath(points), color, scale);
+    }
 }
 
-void LoadTimelineWidget::drawThresholdZones(QPainter &painter, const QRectF &area) {
+void LoadTimelineWidget::paintAsyncCurves(QPainter &painter, qreal dpr, qreal scale) {
+    if (m_asyncDirty || m_model->samplesIngested() != m_asyncSubmittedSamples) {
+        submitAsyncSnapshot(dpr, scale);
+    }
+
+    // 贴最新完成的帧；快照之后经过的时间折算为向左平移，曲线与坐标轴保持同步
+    const LoadAsyncRenderer::Frame frame = m_asyncRenderer->latestFrame();
+    if (frame.image.isNull() || frame.image.size() != size() * dpr) return;
+    const QRectF area = chartRect();
+    const double pxPerMs = area.width() / (m_renderer.timeWindowSeconds() * 1000.0);
+    const double shift = (m_frameNowMs - frame.nowMs) * pxPerMs;
+
+    LoadPhaseScope strokeScope(statsSink(), LoadRenderStats::StrokePhase);
     painter.save();
+    // 左侧按图表边界裁剪，右侧保留当前值标签
+    painter.setClipRect(QRectF(area.left(), 0, width() - area.left(), height()));
+    painter.drawImage(QPointF(-shift, 0), frame.image);
+    painter.restore();
+}
+
+void LoadTimelineWidget::submitAsyncSnapshot(qreal dpr, qreal scale) {
+    m_asyncDirty = false;
+    m_asyncSubmittedSamples = m_model->samplesIngested();
+    if (m_renderer.loadMax() - m_renderer.loadMin() <= 0) return;
+
+    // 快照只含映射后的像素坐标（抽稀后与像素宽度同量级），复制开销与样本总数无关
+    LoadAsyncRenderer::Snapshot snapshot;
+    snapshot.renderer = m_renderer;
+    snapshot.pixelSize = size() * dpr;
+    snapshot.devicePixelRatio = dpr;
+    snapshot.scale = scale;
+    snapshot.area = chartRect();
+    snapshot.nowMs = m_frameNowMs;
+    snapshot.zoneColoring = m_zoneColoredCurve;
+    snapshot.curves.reserve(m_model->seriesCount());
+    for (qsizetype index = 0; index < m_model->seriesCount(); ++index) {
+        const SeriesData &series = m_model->seriesAt(index);
+        snapshot.curves.append(
+            {QVector<QPointF>(mapSamplesToPoints(series, *m_seriesViews[static_cast<size_t>(index)], snapshot.nowMs)),
+             series.color});
+    }
+    const LoadSampleBuffer &primary = primarySeries().buffer;
+    snapshot.labelVisible = m_renderer.currentValueLabelVisible() && primary.size() >= 2;
+    if (snapshot.labelVisible) {
+        snapshot.labelPoint = m_renderer.mapToChart(primary.lastTime(), primary.lastValue(), snapshot.nowMs, snapshot.area);
+        snapshot.labelValue = primary.lastValue();
+    }
+    m_asyncRenderer->submit(std::move(snapshot));
+}
+
+void LoadTimelineWidget::paintHistoryCurve(QPainter &painter, qreal scale) {
+    m_renderer.setTimeAxis(LoadTimelineRenderer::AbsoluteTimeAxis, m_historyStartMs, m_historyEndMs);
+    m_renderer.drawArchiveCurve(painter, chartRect(), *m_historyArchive, primarySeries().color, scale);
+}
+
+void LoadTimelineWidget::invalidateCurveLayer() {
+    m_curveLayerDirty = true;
+    m_asyncDirty = true;
+}
+
+void LoadTimelineWidget::resizeEvent(QResizeEvent *event) {
+    QFrame::resizeEvent(event);
+    invalidateBackground();
+    invalidateCurveLayer();
+}
+
+void LoadTimelineWidget::changeEvent(QEvent *event) {
+    QFrame::changeEvent(event);
+    switch (event->type()) {
+    case QEvent::DevicePixelRatioChange:
+    case QEvent::FontChange:
+    case QEvent::StyleChange:
+        invalidateBackground();
+        invalidateCurveLayer();
+        break;
+    default:
+        break;
+    }
+}
+
+void LoadTimelineWidget::wheelEvent(QWheelEvent *event) {
+    if (!historyActive() || event->angleDelta().y() == 0) {
+        QFrame::wheelEvent(event);
+        return;
+    }
+
+    // 以光标所在时刻为锚点缩放
+    const QRectF area = chartRect();
+    const double span = double(m_historyEndMs - m_historyStartMs);
+    const double ratio = area.width() > 0 ? qBound(0.0, (event->position().x() - area.left()) / area.width(), 1.0) : 0.5;
+    const double anchor = m_historyStartMs + ratio * span;
+    const double factor = qPow(0.8, event->angleDelta().y() / 120.0);
+    const double newSpan = qMax(1000.0, span * factor);
+    const qint64 start = qRound64(anchor - ratio * newSpan);
+    setHistoryRangeMs(start, start + qRound64(newSpan));
+    event->accept();
+}
 
-    const double range = m_loadMax - m_loadMin;
-    if (range <= 0) {
-        painter.restore();
+void LoadTimelineWidget::mousePressEvent(QMouseEvent *event) {
+    if (historyActive() && event->button() == Qt::LeftButton) {
+        m_panning = true;
+        m_panAnchorX = event->position().x();
+        m_panStartMs = m_historyStartMs;
+        m_panEndMs = m_historyEndMs;
+        event->accept();
         return;
     }
+    QFrame::mousePressEvent(event);
+}
+
+void LoadTimelineWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (m_hoverInspectionEnabled && !historyActive()) {
+        updateHover(event->position(), true);
+    }
+    if (m_panning && historyActive()) {
+        const QRectF area = chartRect();
+        if (area.width() > 0) {
+            const double span = double(m_panEndMs - m_panStartMs);
+            const qint64 offset = qRound64(-(event->position().x() - m_panAnchorX) / area.width() * span);
+            setHistoryRangeMs(m_panStartMs + offset, m_panEndMs + offset);
+        }
+        event->accept();
+        return;
+    }
+    QFrame::mouseMoveEvent(event);
+}
+
+void LoadTimelineWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if (m_panning && event->button() == Qt::LeftButton) {
+        m_panning = false;
+        event->accept();
+        return;
+    }
+    QFrame::mouseReleaseEvent(event);
+}
+
+void LoadTimelineWidget::leaveEvent(QEvent *event) {
+    updateHover(m_hover.position, false);
+    QFrame::leaveEvent(event);
+}
 
-    auto toY = [&](double value) {
-        double ratio = (value - m_loadMin) / range;
-        ratio = qBound(0.0, ratio, 1.0);
-        return area.bottom() - ratio * area.height();
+void LoadTimelineWidget::setHoverInspectionEnabled(bool enabled) {
+    if (enabled == m_hoverInspectionEnabled) return;
+    m_hoverInspectionEnabled = enabled;
+    setMouseTracking(enabled);
+    if (!enabled) updateHover(m_hover.position, false);
+    emit hoverInspectionEnabledChanged(enabled);
+}
+
+void LoadTimelineWidget::updateHover(const QPointF &position, bool inside) {
+    const QRegion previous = m_hover.visible ? hoverRegion() : QRegion();
+    const int previousSeries = m_hover.seriesId;
+    const qint64 previousTime = m_hover.timeMs;
+    const bool wasVisible = m_hover.visible;
+
+    m_hover.position = position;
+    m_hover.visible = inside && chartRect().contains(position) && locateHover();
+    if (!m_hover.visible && !wasVisible) return;
+
+    if (m_hover.visible && (!wasVisible || previousSeries != m_hover.seriesId || previousTime != m_hover.timeMs)) {
+        emit sampleHovered(m_hover.seriesId, QDateTime::fromMSecsSinceEpoch(m_hover.timeMs, QTimeZone::UTC),
+                           m_hover.value, m_hover.zone, m_hover.rollup);
+    }
+    if (m_hoverFrame.isNull()) {
+        // 首次显示叠加层：还没有帧缓存，整帧重绘一次并建立缓存
+        update();
+        return;
+    }
+    update(previous | (m_hover.visible ? hoverRegion() : QRegion()));
+}
+
+bool LoadTimelineWidget::locateHover() {
+    const QRectF area = chartRect();
+    if (area.width() <= 0 || m_renderer.timeWindowSeconds() <= 0
+        || m_renderer.loadMax() - m_renderer.loadMin() <= 0) {
+        return false;
+    }
+    // 光标横坐标按上一帧的时刻换算为时间，与屏幕上的曲线一致
+    const qint64 now = m_frameNowMs;
+    const double pxPerMs = area.width() / (m_renderer.timeWindowSeconds() * 1000.0);
+    const qint64 cursorMs = now - qRound64((area.right() - m_hover.position.x()) / pxPerMs);
+    const qint64 windowStart = now - qint64(m_renderer.timeWindowSeconds()) * 1000;
+
+    const SeriesData *best = nullptr;
+    double bestDistance = std::numeric_limits<double>::infinity();
+    LoadRetentionTiers::Bucket bestBucket;
+    auto consider = [&](const SeriesData &series, qint64 timeMs, double value, const LoadRetentionTiers::Bucket *bucket) {
+        if (timeMs < windowStart || timeMs > now) return;
+        const QPointF point = m_renderer.mapToChart(timeMs, value, now, area);
+        const double distance = QLineF(point, m_hover.position).length();
+        if (distance >= bestDistance) return;
+        bestDistance = distance;
+        best = &series;
+        m_hover.timeMs = timeMs;
+        m_hover.value = value;
+        m_hover.point = point;
+        m_hover.rollup = bucket != nullptr;
+        if (bucket) bestBucket = *bucket;
     };
 
-    const double highY = toY(m_highThreshold);
-    const double mediumY = toY(m_mediumThreshold);
+    for (qsizetype s = 0; s < m_model->seriesCount(); ++s) {
+        const SeriesData &series = m_model->seriesAt(s);
+        // 原始样本：二分定位后比较前后两个相邻样本
+        const LoadSampleBuffer &buffer = series.buffer;
+        if (!buffer.isEmpty()) {
+            const qsizetype index = buffer.lowerBound(cursorMs);
+            for (qsizetype i = qMax<qsizetype>(0, index - 1); i <= qMin(index, buffer.size() - 1); ++i) {
+                consider(series, buffer.timeAt(i), buffer.valueAt(i), nullptr);
+            }
+        }
+        // 早于原始样本的部分按汇总桶检视，桶以中点时刻与均值表示
+        const LoadRetentionTiers &tiers = series.tiers;
+        if (!tiers.isEnabled() || tiers.isEmpty() || (!buffer.isEmpty() && cursorMs >= buffer.firstTime())) continue;
+        for (int t = 0; t < tiers.tierCount(); ++t) {
+            const qsizetype count = tiers.bucketCount(t);
+            if (count == 0) continue;
+            const qsizetype index = tiers.lowerBound(t, cursorMs);
+            for (qsizetype i = qMax<qsizetype>(0, index - 1); i <= qMin(index, count - 1); ++i) {
+                const LoadRetentionTiers::Bucket &bucket = tiers.bucketAt(t, i);
+                consider(series, bucket.startMs + (bucket.endTime - bucket.startMs) / 2, bucket.mean(), &bucket);
+            }
+        }
+    }
+    if (!best) return false;
+
+    m_hover.seriesId = best->id;
+    m_hover.zone = static_cast<LoadZone>(best->statistics.zoneFor(m_hover.value));
+    static const char *const zoneNames[] = {"低负荷", "中负荷", "高负荷"};
+    const QString name = best->name.isEmpty() ? QStringLiteral("负荷") : best->name;
+    m_hover.lines.clear();
+    m_hover.lines << QDateTime::fromMSecsSinceEpoch(m_hover.timeMs).toString(QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz"));
+    if (m_hover.rollup) {
+        m_hover.lines << QStringLiteral("%1  均值 %2（%3 ~ %4）")
+                             .arg(name, QString::number(m_hover.value, 'f', 2), QString::number(bestBucket.minValue, 'f', 2),
+                                  QString::number(bestBucket.maxValue, 'f', 2));
+    } else {
+        m_hover.lines << QStringLiteral("%1  %2").arg(name, QString::number(m_hover.value, 'f', 2));
+    }
+    m_hover.lines << QString::fromUtf8(zoneNames[m_hover.zone]);
 
-    painter.fillRect(QRectF(area.left(), area.top(), area.width(), highY - area.top()), QColor(255, 235, 238, 120));
-    painter.fillRect(QRectF(area.left(), highY, area.width(), mediumY - highY), QColor(255, 248, 225, 120));
-    painter.fillRect(QRectF(area.left(), mediumY, area.width(), area.bottom() - mediumY), QColor(232, 245, 233, 120));
+    // 提示框放在光标右下方，超出控件时翻到另一侧
+    const qreal scale = uiScale();
+    QFont tipFont = font();
+    tipFont.setPointSizeF(qMax(8.0, 9.5 * scale));
+    const QFontMetricsF metrics(tipFont);
+    qreal textWidth = 0.0;
+    for (const QString &line : m_hover.lines) {
+        textWidth = qMax(textWidth, metrics.horizontalAdvance(line));
+    }
+    const qreal padding = 6.0 * scale;
+    const QSizeF tipSize(textWidth + padding * 2, metrics.height() * m_hover.lines.size() + padding * 2);
+    const qreal offset = 14.0 * scale;
+    QPointF topLeft = m_hover.position + QPointF(offset, offset);
+    if (topLeft.x() + tipSize.width() > width()) topLeft.setX(m_hover.position.x() - offset - tipSize.width());
+    if (topLeft.y() + tipSize.height() > height()) topLeft.setY(m_hover.position.y() - offset - tipSize.height());
+    m_hover.tooltipRect = QRectF(QPointF(qMax<qreal>(0.0, topLeft.x()), qMax<qreal>(0.0, topLeft.y())), tipSize);
+    return true;
+}
 
-    painter.restore();
+QRegion LoadTimelineWidget::hoverRegion() const {
+    const QRectF area = chartRect();
+    const qreal scale = uiScale();
+    // 留出抗锯齿与线宽的余量
+    const qreal margin = 2.0 * scale + 1.0;
+    const qreal radius = 4.0 * scale + margin;
+    QRegion region;
+    region += QRectF(m_hover.point.x() - margin, area.top(), margin * 2, area.height()).toAlignedRect();
+    region += QRectF(area.left(), m_hover.point.y() - margin, area.width(), margin * 2).toAlignedRect();
+    region += QRectF(m_hover.point - QPointF(radius, radius), QSizeF(radius * 2, radius * 2)).toAlignedRect();
+    region += m_hover.tooltipRect.adjusted(-margin, -margin, margin, margin).toAlignedRect();
+    return region;
 }
 
-void LoadTimelineWidget::drawCurrentValueLabel(QPainter &painter, const QPointF &point, double value, qreal scale) {
+void LoadTimelineWidget::drawHoverOverlay(QPainter &painter) const {
+    const QRectF area = chartRect();
+    const qreal scale = uiScale();
     painter.save();
-    QString text = QString::number(value, 'f', 1);
-    QFont font = painter.font();
-    font.setBold(true);
-    font.setPointSizeF(qMax(10.0, 11.0 * scale));
-    painter.setFont(font);
-
-    QColor textColor = colorForLoad(value);
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(QColor(255, 255, 255, 220));
-    QFontMetricsF metrics(font);
-    const qreal textWidth = metrics.horizontalAdvance(text) + 12.0 * scale;
-    const qreal textHeight = metrics.height() + 6.0 * scale;
-    QRectF rect(point.x() + 8.0 * scale, point.y() - textHeight, textWidth, textHeight);
-    painter.drawRoundedRect(rect, 4.0 * scale, 4.0 * scale);
+    painter.setRenderHint(QPainter::Antialiasing, true);
 
-    painter.setPen(QPen(textColor, 1.0 * scale));
-    painter.drawText(rect.adjusted(4, 0, -4, 0), Qt::AlignVCenter | Qt::AlignLeft, text);
+    // 十字线：穿过命中样本的横竖虚线，限制在图表区域内
+    painter.save();
+    painter.setClipRect(area);
+    painter.setPen(QPen(QColor(60, 60, 60, 160), 1.0 * scale, Qt::DashLine));
+    painter.drawLine(QPointF(m_hover.point.x(), area.top()), QPointF(m_hover.point.x(), area.bottom()));
+    painter.drawLine(QPointF(area.left(), m_hover.point.y()), QPointF(area.right(), m_hover.point.y()));
+    painter.restore();
 
-    painter.setPen(QPen(textColor, 2.0 * scale));
-    painter.drawEllipse(point, 4.0 * scale, 4.0 * scale);
+    painter.setPen(QPen(Qt::white, 1.5 * scale));
+    painter.setBrush(LoadTimelineRenderer::zoneColor(m_hover.zone));
+    painter.drawEllipse(m_hover.point, 4.0 * scale, 4.0 * scale);
 
+    // 提示框：时刻、序列与负荷值、分区
+    painter.setPen(QPen(QColor(120, 120, 120), 1.0));
+    painter.setBrush(QColor(255, 255, 255, 235));
+    painter.drawRoundedRect(m_hover.tooltipRect, 4.0 * scale, 4.0 * scale);
+    QFont tipFont = font();
+    tipFont.setPointSizeF(qMax(8.0, 9.5 * scale));
+    painter.setFont(tipFont);
+    const QFontMetricsF metrics(tipFont);
+    const qreal padding = 6.0 * scale;
+    QPointF baseline = m_hover.tooltipRect.topLeft() + QPointF(padding, padding + metrics.ascent());
+    for (int i = 0; i < m_hover.lines.size(); ++i) {
+        painter.setPen(i == m_hover.lines.size() - 1 ? LoadTimelineRenderer::zoneColor(m_hover.zone) : QColor(40, 40, 40));
+        painter.drawText(baseline, m_hover.lines.at(i));
+        baseline.ry() += metrics.height();
+    }
     painter.restore();
 }
 
+void LoadTimelineWidget::invalidateBackground() {
+    m_backgroundDirty = true;
+    m_asyncDirty = true;
+}
+
+void LoadTimelineWidget::acquireBackground(qreal dpr, qreal scale) {
+    // 历史回看按可见范围标注绝对时刻，实时模式标注相对秒数
+    if (historyActive()) {
+        m_renderer.setTimeAxis(LoadTimelineRenderer::AbsoluteTimeAxis, m_historyStartMs, m_historyEndMs);
+    } else {
+        m_renderer.setTimeAxis(LoadTimelineRenderer::RelativeTimeAxis);
+    }
+
+    // 仪表盘中尺寸与外观相同的控件共用一张背景，只有第一个控件实际绘制
+    QByteArray key = m_renderer.backgroundKey();
+    {
+        QDataStream stream(&key, QIODevice::Append);
+        stream << size() << dpr << scale << font().key();
+    }
+    m_background = LoadBackgroundCache::acquire(key, [this, dpr, scale]() {
+        QPixmap pixmap(size() * dpr);
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+
+        QPainter painter(&pixmap);
+        painter.setFont(font());
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        m_renderer.drawBackground(painter, chartRect(), scale);
+        return pixmap;
+    });
+
+    m_backgroundDirty = false;
+}
+
+QRectF LoadTimelineWidget::chartRect() const {
+    return LoadTimelineRenderer::chartRect(QRectF(rect()), uiScale());
+}
+
+qreal LoadTimelineWidget::uiScale() const {
+    return LoadTimelineRenderer::uiScale(QSizeF(size()), devicePixelRatioF());
+}
+
+const QVector<QPointF> &LoadTimelineWidget::mapSamplesToPoints(const SeriesData &series, SeriesView &view,
+                                                                double nowMs) const {
+    LoadPhaseScope scope(statsSink(), LoadRenderStats::MapPhase);
+    const LoadSampleBuffer &buffer = series.buffer;
+    const LoadDecimationPyramid &pyramid = series.pyramid;
+    QVector<QPointF> &mapped = view.mappedPoints;
+    mapped.resize(0);
+    // 模型可能保留了更长的数据（与更宽的视图共用）：自窗口起点前一个样本开始映射，左缘保持连续
+    const qint64 windowStart = qint64(nowMs) - qint64(m_renderer.timeWindowSeconds()) * 1000;
+    const qsizetype first = qMax<qsizetype>(0, buffer.lowerBound(windowStart) - 1);
+    const bool hasTiers = series.tiers.isEnabled() && !series.tiers.isEmpty()
+        && (buffer.isEmpty() || buffer.firstTime() > windowStart);
+    if (buffer.isEmpty() && !hasTiers) return mapped;
+
+    QRectF area = chartRect();
+    const double loadRange = m_renderer.loadMax() - m_renderer.loadMin();
+    if (loadRange <= 0) return mapped;
+
+    const LoadMappingKernel::Transform transform = LoadMappingKernel::makeTransform(
+        nowMs, m_renderer.timeWindowSeconds(), m_renderer.loadMin(), m_renderer.loadMax(), area);
+
+    const int level = LoadDecimationPyramid::levelFor(buffer.size() - first, area.width());
+    if (level == 0 && !hasTiers) {
+        // 原始样本：按环形缓冲区的连续段整段映射
+        mapped.resize(buffer.size() - first);
+        LoadSampleBuffer::Segment segments[2];
+        const int segmentCount = buffer.segments(first, buffer.size() - first, segments);
+        QPointF *out = mapped.data();
+        for (int i = 0; i < segmentCount; ++i) {
+            LoadMappingKernel::map(transform, segments[i].times, segments[i].values, segments[i].count, out);
+            out += segments[i].count;
+        }
+        return mapped;
+    }
+
+    // 抽稀：先按时间先后收集每桶的最小/最大值，再整批映射，保证峰值可见
+    QVector<qint64> &times = m_gatherTimes;
+    QVector<double> &values = m_gatherValues;
+    times.resize(0);
+    values.resize(0);
+    auto gather = [&](qint64 timeMs, double value) {
+        times.append(timeMs);
+        values.append(value);
+    };
+    auto gatherExtrema = [&](qint64 minTime, double minValue, qint64 maxTime, double maxValue) {
+        if (minTime == maxTime) {
+            gather(minTime, minValue);
+        } else if (minTime < maxTime) {
+            gather(minTime, minValue);
+            gather(maxTime, maxValue);
+        } else {
+            gather(maxTime, maxValue);
+            gather(minTime, minValue);
+        }
+    };
+
+    // 汇总层的数据早于全部原始样本，排在最前
+    if (hasTiers) gatherTierPoints(series, windowStart, times, values, true);
+    if (level == 0) {
+        for (qsizetype i = first; i < buffer.size(); ++i) {
+            gather(buffer.timeAt(i), buffer.valueAt(i));
+        }
+    }
+
+    const int shift = LoadDecimationPyramid::bucketShift(level);
+    const qsizetype bucketCount = level > 0 ? pyramid.bucketCount(level) : 0;
+    const qint64 firstSequence = buffer.firstSequence();
+    const qint64 startSequence = firstSequence + first;
+    const qsizetype firstBucket =
+        level > 0 ? qMax<qsizetype>(0, (startSequence >> shift) - pyramid.firstBucketIndex(level)) : 0;
+    times.reserve(times.size() + (bucketCount - firstBucket) * 2 + 1);
+    values.reserve(values.size() + (bucketCount - firstBucket) * 2 + 1);
+
+    for (qsizetype b = firstBucket; b < bucketCount; ++b) {
+        const qint64 bucketStart = (pyramid.firstBucketIndex(level) + b) << shift;
+        if (bucketStart < startSequence) {
+            // 首桶已被部分裁剪或部分早于窗口：仅对其余原始样本重新求极值，避免显示窗口外的峰值
+            const qsizetype end = qMin<qsizetype>(bucketStart + (qint64(1) << shift) - firstSequence, buffer.size());
+            qsizetype minIndex = first;
+            qsizetype maxIndex = first;
+            for (qsizetype i = first + 1; i < end; ++i) {
+                if (buffer.valueAt(i) < buffer.valueAt(minIndex)) minIndex = i;
+                if (buffer.valueAt(i) > buffer.valueAt(maxIndex)) maxIndex = i;
+            }
+            gatherExtrema(buffer.timeAt(minIndex), buffer.valueAt(minIndex),
+                          buffer.timeAt(maxIndex), buffer.valueAt(maxIndex));
+            continue;
+        }
+        const LoadDecimationPyramid::Bucket &bucket = pyramid.bucketAt(level, b);
+        gatherExtrema(bucket.minTime, bucket.minValue, bucket.maxTime, bucket.maxValue);
+    }
+
+    // 曲线末端始终落在最新样本上，便于绘制当前值标签
+    if (!buffer.isEmpty()
+        && (times.isEmpty() || times.constLast() != buffer.lastTime() || values.constLast() != buffer.lastValue())) {
+        gather(buffer.lastTime(), buffer.lastValue());
+    }
+
+    mapped.resize(times.size());
+    LoadMappingKernel::map(transform, times.constData(), values.constData(), times.size(), mapped.data());
+    return mapped;
+}
+
+void LoadTimelineWidget::gatherTierPoints(const SeriesData &series, qint64 windowStartMs, QVector<qint64> &times,
+                                          QVector<double> &values, bool includeOpen) const {
+    const LoadRetentionTiers &tiers = series.tiers;
+    if (!tiers.isEnabled() || tiers.isEmpty()) return;
+
+    // 按绝对时间划分像素列，列边界不随时间推进移动，缓存的汇总路径在两次重建之间保持一致
+    const double columns = qMax(1.0, chartRect().width());
+    const qint64 msPerColumn = qMax<qint64>(1, qint64(m_renderer.timeWindowSeconds() * 1000.0 / columns));
+    bool open = false;
+    qint64 column = 0;
+    LoadRetentionTiers::Bucket extrema;
+    auto flush = [&]() {
+        if (!open) return;
+        if (extrema.minTime <= extrema.maxTime) {
+            times.append(extrema.minTime);
+            values.append(extrema.minValue);
+            if (extrema.maxTime != extrema.minTime) {
+                times.append(extrema.maxTime);
+                values.append(extrema.maxValue);
+            }
+        } else {
+            times.append(extrema.maxTime);
+            values.append(extrema.maxValue);
+            times.append(extrema.minTime);
+            values.append(extrema.minValue);
+        }
+    };
+
+    // 最粗的层级数据最旧，自后向前遍历即按时间先后
+    for (int t = tiers.tierCount() - 1; t >= 0; --t) {
+        const qsizetype count = tiers.bucketCount(t) - (t == 0 && !includeOpen && tiers.bucketCount(0) > 0 ? 1 : 0);
+        // 与更宽的视图共用模型时跳过窗口之前的桶；保留紧邻窗口的一个以连接左缘
+        for (qsizetype i = qMax<qsizetype>(0, tiers.lowerBound(t, windowStartMs) - 1); i < count; ++i) {
+            const LoadRetentionTiers::Bucket &bucket = tiers.bucketAt(t, i);
+            const qint64 bucketColumn = bucket.startMs / msPerColumn;
+            if (open && bucketColumn == column) {
+                if (bucket.minValue < extrema.minValue) {
+                    extrema.minValue = bucket.minValue;
+                    extrema.minTime = bucket.minTime;
+                }
+                if (bucket.maxValue > extrema.maxValue) {
+                    extrema.maxValue = bucket.maxValue;
+                    extrema.maxTime = bucket.maxTime;
+                }
+                continue;
+            }
+            flush();
+            open = true;
+            column = bucketColumn;
+            extrema = bucket;
+        }
+    }
+    flush();
+}
+
+void LoadTimelineWidget::syncTierPaths(const SeriesData &series, SeriesView &view,
+                                       const LoadPathCache::Geometry &geometry) {
+    QVector<qint64> &times = m_gatherTimes;
+    QVector<double> &values = m_gatherValues;
+
+    // 已完成的汇总桶只在层级结构变化（新桶、下移、丢弃）或几何变化时重建
+    if (!view.tierPath.isValid() || view.tierPath.geometry() != geometry
+        || view.tierPathRevision != series.tiers.revision()) {
+        times.resize(0);
+        values.resize(0);
+        gatherTierPoints(series, m_frameNowMs - qint64(m_renderer.timeWindowSeconds()) * 1000, times, values, false);
+        view.tierPath.rebuildFromPoints(times.constData(), values.constData(), times.size(), geometry, m_frameNowMs);
+        view.tierPathRevision = series.tiers.revision();
+        view.tierPathHasEnd = !times.isEmpty();
+        if (view.tierPathHasEnd) {
+            view.tierPathEndTime = times.constLast();
+            view.tierPathEndValue = values.constLast();
+        }
+    }
+
+    // 连接段：缓存路径末点 → 第 0 层仍在接收样本的桶 → 最早的原始样本，仅数个点，每帧重建
+    times.resize(0);
+    values.resize(0);
+    if (view.tierPathHasEnd) {
+        times.append(view.tierPathEndTime);
+        values.append(view.tierPathEndValue);
+    }
+    const LoadRetentionTiers &tiers = series.tiers;
+    if (tiers.tierCount() > 0 && tiers.bucketCount(0) > 0) {
+        const LoadRetentionTiers::Bucket &bucket = tiers.bucketAt(0, tiers.bucketCount(0) - 1);
+        const bool minFirst = bucket.minTime <= bucket.maxTime;
+        times.append(minFirst ? bucket.minTime : bucket.maxTime);
+        values.append(minFirst ? bucket.minValue : bucket.maxValue);
+        if (bucket.minTime != bucket.maxTime) {
+            times.append(minFirst ? bucket.maxTime : bucket.minTime);
+            values.append(minFirst ? bucket.maxValue : bucket.minValue);
+        }
+    }
+    if (!series.buffer.isEmpty()) {
+        times.append(series.buffer.firstTime());
+        values.append(series.buffer.valueAt(0));
+    }
+    view.tierBridge.rebuildFromPoints(times.constData(), values.constData(), times.size(), geometry, m_frameNowMs);
+}
+
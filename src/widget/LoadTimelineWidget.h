@@ -1,22 +1,56 @@
 #pragma once
 
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QFrame>
+#include <QList>
+#include <QLineF>
 #include <QLinearGradient>
 #include <QPainterPath>
+#include <QPixmap>
+#include <QRegion>
+#include <QStringList>
+#include <QTimer>
 #include <QVector>
 
+#include "LoadAnnotationIndex.h"
+#include "LoadAsyncRenderer.h"
+#include "LoadClock.h"
+#include "LoadPathCache.h"
+#include "LoadRenderStats.h"
+#include "LoadRetentionTiers.h"
+#include "LoadSampleQueue.h"
+#include "LoadSessionArchive.h"
+#include "LoadSignalPipeline.h"
+#include "LoadTimelineModel.h"
+#include "LoadTimelineRenderer.h"
+#include "LoadZoneStatistics.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
 // 心理负荷时间轴控件：用于展示一段时间内的负荷趋势，支持高/中/低分段显示。
+// 数据存放在 LoadTimelineModel 中：控件默认持有一个私有模型，也可通过 setModel() 与其他控件共用同一个模型；
+// 控件上的数据接口均转发给当前模型。
 class LoadTimelineWidget : public QFrame {
     Q_OBJECT
     // 时间窗口（秒），控制横坐标范围
     Q_PROPERTY(int timeWindowSeconds READ timeWindowSeconds WRITE setTimeWindowSeconds NOTIFY timeWindowSecondsChanged)
     // 刻度间隔（秒），横坐标刻度显示间隔
     Q_PROPERTY(int tickIntervalSeconds READ tickIntervalSeconds WRITE setTickIntervalSeconds NOTIFY tickIntervalSecondsChanged)
-    // 纵轴最小值
+    // 纵轴最小值（启用自动量程时为无数据时的默认范围）
     Q_PROPERTY(double loadMin READ loadMin WRITE setLoadMin NOTIFY loadRangeChanged)
-    // 纵轴最大值
+    // 纵轴最大值（启用自动量程时为无数据时的默认范围）
     Q_PROPERTY(double loadMax READ loadMax WRITE setLoadMax NOTIFY loadRangeChanged)
+    // 自动量程：纵轴范围跟随时间窗口内所有序列的最小/最大值
+    Q_PROPERTY(bool autoScaleEnabled READ autoScaleEnabled WRITE setAutoScaleEnabled NOTIFY autoScaleEnabledChanged)
+    // 自动量程上下留白，占数据跨度的比例
+    Q_PROPERTY(double autoScalePadding READ autoScalePadding WRITE setAutoScalePadding NOTIFY autoScalePaddingChanged)
+    // 自动量程端点取整到整齐刻度（1/2/2.5/5 × 10^n 的整数倍）
+    Q_PROPERTY(bool autoScaleNiceRange READ autoScaleNiceRange WRITE setAutoScaleNiceRange NOTIFY autoScaleNiceRangeChanged)
+    // 自动量程范围变化的过渡时长（毫秒），0 表示立即切换
+    Q_PROPERTY(int autoScaleAnimationMs READ autoScaleAnimationMs WRITE setAutoScaleAnimationMs NOTIFY autoScaleAnimationMsChanged)
     // 高负荷阈值（超过即显示高负荷颜色）
     Q_PROPERTY(double highThreshold READ highThreshold WRITE setHighThreshold NOTIFY thresholdChanged)
     // 中负荷阈值（超过即显示中负荷颜色）
@@ -29,35 +63,171 @@ class LoadTimelineWidget : public QFrame {
     Q_PROPERTY(bool gridVisible READ gridVisible WRITE setGridVisible NOTIFY gridVisibilityChanged)
     // 是否使用平滑曲线
     Q_PROPERTY(bool smoothingEnabled READ smoothingEnabled WRITE setSmoothingEnabled NOTIFY smoothingChanged)
+    // 分区着色曲线：曲线在阈值穿越处切分，按所在分区着色（替代序列颜色）
+    Q_PROPERTY(bool zoneColoredCurve READ zoneColoredCurve WRITE setZoneColoredCurve NOTIFY zoneColoredCurveChanged)
     // 是否在末尾显示当前值标签
     Q_PROPERTY(bool currentValueLabelVisible READ currentValueLabelVisible WRITE setCurrentValueLabelVisible NOTIFY labelVisibilityChanged)
+    // 是否启用滚动贴图模式：平移上一帧曲线，仅绘制新露出的右侧片段
+    Q_PROPERTY(bool scrollBlitEnabled READ scrollBlitEnabled WRITE setScrollBlitEnabled NOTIFY scrollBlitChanged)
+    // 异步绘制：曲线在共享工作线程池中栅格化，GUI 线程只贴最新完成的帧
+    Q_PROPERTY(bool asyncRenderingEnabled READ asyncRenderingEnabled WRITE setAsyncRenderingEnabled NOTIFY asyncRenderingChanged)
+    // 数据驱动重绘的最高帧率（0 表示不限制）
+    Q_PROPERTY(int maxFrameRate READ maxFrameRate WRITE setMaxFrameRate NOTIFY maxFrameRateChanged)
+    // 历史回看模式：显示已打开的会话归档，可用滚轮缩放、拖动平移
+    Q_PROPERTY(bool historyMode READ historyMode WRITE setHistoryMode NOTIFY historyModeChanged)
+    // 是否采集绘制/接入运行统计（关闭时开销可忽略）
+    Q_PROPERTY(bool instrumentationEnabled READ instrumentationEnabled WRITE setInstrumentationEnabled NOTIFY instrumentationChanged)
+    // 是否在图表左上角显示运行统计叠加层
+    Q_PROPERTY(bool debugOverlayVisible READ debugOverlayVisible WRITE setDebugOverlayVisible NOTIFY debugOverlayChanged)
+    // 分区切换滞回量：向下离开分区需低于阈值减该值
+    Q_PROPERTY(double zoneHysteresis READ zoneHysteresis WRITE setZoneHysteresis NOTIFY zoneHysteresisChanged)
+    // 分区切换去抖时长（毫秒）：新分区持续该时长后才确认切换
+    Q_PROPERTY(int zoneDebounceMs READ zoneDebounceMs WRITE setZoneDebounceMs NOTIFY zoneDebounceMsChanged)
+    // 原始样本保留时长（秒）：更早的样本折叠为分层汇总桶；0 或不小于时间窗口时全部保留原始样本
+    Q_PROPERTY(int rawRetentionSeconds READ rawRetentionSeconds WRITE setRawRetentionSeconds NOTIFY rawRetentionSecondsChanged)
+    // 数据存储内存预算（字节）：样本缓冲、抽稀索引与汇总层的总占用不超过该值；0 表示不限制
+    Q_PROPERTY(qint64 memoryBudgetBytes READ memoryBudgetBytes WRITE setMemoryBudgetBytes NOTIFY memoryBudgetBytesChanged)
+    // 悬停检视：鼠标悬停时以十字线与提示框显示最近样本的时刻、负荷值与分区（实时模式）
+    Q_PROPERTY(bool hoverInspectionEnabled READ hoverInspectionEnabled WRITE setHoverInspectionEnabled NOTIFY hoverInspectionEnabledChanged)
+    // 是否绘制标注层（点事件与时间区间）
+    Q_PROPERTY(bool annotationsVisible READ annotationsVisible WRITE setAnnotationsVisible NOTIFY annotationsVisibleChanged)
 
 public:
     explicit LoadTimelineWidget(QWidget *parent = nullptr);
+    ~LoadTimelineWidget() override;
 
-    // 数据结构：时间戳 + 负荷值
-    struct Sample {
-        QDateTime timestamp;
-        double loadValue = 0.0;
+    // 负荷分区
+    enum LoadZone {
+        LowLoad = 0,
+        MediumLoad = 1,
+        HighLoad = 2
     };
+    Q_ENUM(LoadZone)
+
+    // 数据结构：时间戳 + 负荷值
+    using Sample = LoadTimelineModel::Sample;
 
-    // 数据管理接口
+    // 主序列编号：单序列数据接口均作用于主序列，主序列不可移除
+    static constexpr int PrimarySeriesId = LoadTimelineModel::PrimarySeriesId;
+
+    // 数据模型：传入 nullptr 时恢复为新的私有模型。控件不取得外部模型的所有权，
+    // 外部模型先于控件销毁时同样恢复为私有模型。附着时采用模型的分区阈值
+    void setModel(LoadTimelineModel *model);
+    LoadTimelineModel *model() const { return m_model; }
+
+    // 数据管理接口（主序列）
     void appendSample(const Sample &sample);
+    // 批量追加：整批只裁剪一次、只请求一次重绘
+    void appendSamples(const Sample *samples, qsizetype count);
+    void appendSamples(const QVector<Sample> &samples);
     void setSamples(const QVector<Sample> &samples);
-    QVector<Sample> samples() const { return m_samples; }
+    QVector<Sample> samples() const;
+
+    // 多序列接口：所有序列共享时间轴、背景与坐标轴，在同一次绘制中逐序列绘制曲线
+    int addSeries(const QString &name, const QColor &color);
+    bool removeSeries(int seriesId);
+    QList<int> seriesIds() const;
+    QString seriesName(int seriesId) const;
+    void setSeriesName(int seriesId, const QString &name);
+    QColor seriesColor(int seriesId) const;
+    void setSeriesColor(int seriesId, const QColor &color);
+    void appendSeriesSample(int seriesId, const Sample &sample);
+    void appendSeriesSamples(int seriesId, const Sample *samples, qsizetype count);
+    // 列式批量追加（UTC 毫秒时间戳与负荷值），不经 QDateTime 转换
+    void appendSeriesSamples(int seriesId, const qint64 *timesMs, const double *values, qsizetype count);
+    void setSeriesSamples(int seriesId, const QVector<Sample> &samples);
+    QVector<Sample> seriesSamples(int seriesId) const;
+
+    // 接入信号调理：样本在写入存储前经过该序列的处理级（EMA、滑动中值、降采样、离群值剔除）；
+    // 设置时清空处理级状态，已存储的样本不受影响。空管线表示原样存储
+    void setIngestPipeline(int seriesId, const LoadSignalPipeline &pipeline);
+    // 当前管线（含输入/输出/剔除计数）
+    LoadSignalPipeline ingestPipeline(int seriesId = PrimarySeriesId) const;
+
+    // 标注：点事件（告警、操作员干预等）与时间区间（任务阶段等），绘制在曲线之后；
+    // 颜色无效时使用默认颜色，离开时间窗口后随样本裁剪一起过期。返回标注编号
+    quint64 addAnnotation(const QDateTime &timestamp, const QString &label, const QColor &color = QColor());
+    quint64 addAnnotation(const QDateTime &start, const QDateTime &end, const QString &label,
+                          const QColor &color = QColor());
+    bool removeAnnotation(quint64 id);
+    void clearAnnotations();
+    qsizetype annotationCount() const { return m_model->annotationCount(); }
+
+    // 分层保留的汇总层级（默认 1 秒桶保留 1 小时，其后 10 秒桶），rawRetentionSeconds > 0 时生效
+    void setRetentionTiers(const QVector<LoadRetentionTiers::Tier> &tiers);
+    QVector<LoadRetentionTiers::Tier> retentionTiers() const { return m_model->retentionTiers(); }
+    // 当前数据存储占用（样本缓冲、抽稀索引与汇总层，按已分配容量计）
+    qint64 memoryUsageBytes() const;
+
+    // 窗口内各分区驻留时长统计（随样本进入与离开窗口增量维护）
+    LoadZoneStatistics::Dwell zoneDwell(int seriesId = PrimarySeriesId) const;
+
+    // 绘制器：外观属性与绘制逻辑，可复制后在工作线程中绘制到 QImage/QPdfWriter
+    const LoadTimelineRenderer &renderer() const { return m_renderer; }
+
+    // 运行统计快照：分阶段耗时、帧数、接入速率与缓冲占用
+    LoadRenderStats renderStats() const;
+
+    // 时间源：默认为进程共享的实时时钟，回放时替换为虚拟时钟；每帧只读取一次
+    void setClock(std::shared_ptr<LoadClock> clock);
+    std::shared_ptr<LoadClock> clock() const { return m_clock; }
+
+    // 会话归档：打开归档供历史回看（只读取块索引，数据按需映射）
+    bool openHistoryArchive(const QString &path);
+    void closeHistoryArchive();
+    bool hasHistoryArchive() const { return m_historyArchive != nullptr; }
+    void setHistoryRange(const QDateTime &start, const QDateTime &end);
+    QDateTime historyRangeStart() const;
+    QDateTime historyRangeEnd() const;
+    // 会话录制：主序列样本同时追加写入归档文件
+    bool startRecording(const QString &path);
+    void stopRecording();
+    bool isRecording() const { return m_model->isRecording(); }
+    // 本次录制中未能写入归档的样本数（时间戳早于上一个录制样本或写入失败）
+    quint64 recordingRejectedCount() const { return m_model->recordingRejectedCount(); }
+
+    // 跨线程数据接口：生产者句柄可在任意线程写入，控件按重绘节拍批量取出
+    LoadSampleProducer createProducer(qsizetype capacity = 16384);
+    LoadSampleProducer createSeriesProducer(int seriesId, qsizetype capacity = 16384);
+    // 所有生产者队列中尚未取出的样本数
+    qsizetype queuedSampleCount() const;
+    // 队列写满而被丢弃的样本总数
+    quint64 droppedSampleCount() const;
+    // 因内存预算在离开时间窗口之前被丢弃的样本总数
+    quint64 evictedSampleCount() const { return m_model->evictedSampleCount(); }
 
     // 属性访问器
-    int timeWindowSeconds() const { return m_timeWindowSeconds; }
-    int tickIntervalSeconds() const { return m_tickIntervalSeconds; }
+    int timeWindowSeconds() const { return m_renderer.timeWindowSeconds(); }
+    int tickIntervalSeconds() const { return m_renderer.tickIntervalSeconds(); }
     double loadMin() const { return m_loadMin; }
     double loadMax() const { return m_loadMax; }
-    double highThreshold() const { return m_highThreshold; }
-    double mediumThreshold() const { return m_mediumThreshold; }
-    QColor gradientStart() const { return m_gradientStart; }
-    QColor gradientEnd() const { return m_gradientEnd; }
-    bool gridVisible() const { return m_gridVisible; }
-    bool smoothingEnabled() const { return m_smoothingEnabled; }
-    bool currentValueLabelVisible() const { return m_currentValueLabelVisible; }
+    // 当前实际显示的纵轴范围（自动量程时随数据变化）
+    double displayedLoadMin() const { return m_renderer.loadMin(); }
+    double displayedLoadMax() const { return m_renderer.loadMax(); }
+    double highThreshold() const { return m_renderer.highThreshold(); }
+    double mediumThreshold() const { return m_renderer.mediumThreshold(); }
+    QColor gradientStart() const { return m_renderer.gradientStart(); }
+    QColor gradientEnd() const { return m_renderer.gradientEnd(); }
+    bool gridVisible() const { return m_renderer.gridVisible(); }
+    bool smoothingEnabled() const { return m_renderer.smoothingEnabled(); }
+    bool zoneColoredCurve() const { return m_zoneColoredCurve; }
+    bool currentValueLabelVisible() const { return m_renderer.currentValueLabelVisible(); }
+    bool scrollBlitEnabled() const { return m_scrollBlitEnabled; }
+    bool asyncRenderingEnabled() const { return m_asyncRenderer != nullptr; }
+    int maxFrameRate() const { return m_maxFrameRate; }
+    bool historyMode() const { return m_historyMode; }
+    bool instrumentationEnabled() const { return m_instrumentationEnabled; }
+    bool debugOverlayVisible() const { return m_debugOverlayVisible; }
+    double zoneHysteresis() const { return m_model->zoneHysteresis(); }
+    int zoneDebounceMs() const { return m_model->zoneDebounceMs(); }
+    int rawRetentionSeconds() const { return m_model->rawRetentionSeconds(); }
+    qint64 memoryBudgetBytes() const { return m_model->memoryBudgetBytes(); }
+    bool autoScaleEnabled() const { return m_autoScaleEnabled; }
+    double autoScalePadding() const { return m_autoScalePadding; }
+    bool autoScaleNiceRange() const { return m_autoScaleNiceRange; }
+    int autoScaleAnimationMs() const { return m_autoScaleAnimationMs; }
+    bool hoverInspectionEnabled() const { return m_hoverInspectionEnabled; }
+    bool annotationsVisible() const { return m_annotationsVisible; }
 
 public slots:
     void setTimeWindowSeconds(int seconds);
@@ -70,7 +240,24 @@ public slots:
     void setGradientEnd(const QColor &color);
     void setGridVisible(bool visible);
     void setSmoothingEnabled(bool enabled);
+    void setZoneColoredCurve(bool enabled);
     void setCurrentValueLabelVisible(bool visible);
+    void setScrollBlitEnabled(bool enabled);
+    void setAsyncRenderingEnabled(bool enabled);
+    void setMaxFrameRate(int fps);
+    void setHistoryMode(bool enabled);
+    void setInstrumentationEnabled(bool enabled);
+    void setDebugOverlayVisible(bool visible);
+    void setZoneHysteresis(double value);
+    void setZoneDebounceMs(int ms);
+    void setRawRetentionSeconds(int seconds);
+    void setMemoryBudgetBytes(qint64 bytes);
+    void setAutoScaleEnabled(bool enabled);
+    void setAutoScalePadding(double fraction);
+    void setAutoScaleNiceRange(bool enabled);
+    void setAutoScaleAnimationMs(int ms);
+    void setHoverInspectionEnabled(bool enabled);
+    void setAnnotationsVisible(bool visible);
 
 signals:
     void timeWindowSecondsChanged(int value);
@@ -80,35 +267,233 @@ signals:
     void gradientChanged();
     void gridVisibilityChanged(bool visible);
     void smoothingChanged(bool enabled);
+    void zoneColoredCurveChanged(bool enabled);
     void labelVisibilityChanged(bool visible);
+    void scrollBlitChanged(bool enabled);
+    void asyncRenderingChanged(bool enabled);
+    void maxFrameRateChanged(int fps);
+    void seriesListChanged();
+    void modelChanged(LoadTimelineModel *model);
+    void historyModeChanged(bool enabled);
+    void instrumentationChanged(bool enabled);
+    void debugOverlayChanged(bool visible);
+    // 启用统计时每秒发布一次
+    void renderStatsUpdated(const LoadRenderStats &stats);
+    void historyRangeChanged(const QDateTime &start, const QDateTime &end);
+    void zoneHysteresisChanged(double value);
+    void zoneDebounceMsChanged(int ms);
+    void rawRetentionSecondsChanged(int seconds);
+    void memoryBudgetBytesChanged(qint64 bytes);
+    void autoScaleEnabledChanged(bool enabled);
+    void autoScalePaddingChanged(double fraction);
+    void autoScaleNiceRangeChanged(bool enabled);
+    void autoScaleAnimationMsChanged(int ms);
+    // 实际显示的纵轴范围变化（自动量程过渡中按限速节奏发出）
+    void displayedLoadRangeChanged(double minValue, double maxValue);
+    void hoverInspectionEnabledChanged(bool enabled);
+    void annotationsVisibleChanged(bool visible);
+    // 悬停检视的样本变化；rollup 为真时 value 为汇总桶均值
+    void sampleHovered(int seriesId, const QDateTime &timestamp, double value, LoadTimelineWidget::LoadZone zone,
+                       bool rollup);
+    // 序列负荷分区确认切换（已应用滞回与去抖）
+    void loadZoneChanged(int seriesId, LoadTimelineWidget::LoadZone previous, LoadTimelineWidget::LoadZone current,
+                         const QDateTime &timestamp);
+    // 录制归档定时写出失败
+    void recordingError(const QString &message);
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void changeEvent(QEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
 
 private:
+    // 帧调度器按节拍派发待绘制的控件
+    friend class LoadFrameScheduler;
+
+    using SeriesData = LoadTimelineModel::Series;
+
+    // 单条曲线在本控件中的绘制状态（数据在模型中），与模型的序列按下标一一对应
+    struct SeriesView {
+        int id = PrimarySeriesId;
+        // 已完成汇总桶的路径（层级结构变化时重建）与连接到原始样本的短连接段（每帧重建）
+        LoadPathCache tierPath;
+        LoadPathCache tierBridge;
+        quint64 tierPathRevision = 0;
+        bool tierPathHasEnd = false;
+        qint64 tierPathEndTime = 0;
+        double tierPathEndValue = 0.0;
+        // 已完成汇总桶的极值，层级结构变化时重算
+        quint64 tierExtremaRevision = 0;
+        bool tierExtremaValid = false;
+        double tierExtremaMin = 0.0;
+        double tierExtremaMax = 0.0;
+        // 滚动贴图模式下已绘制到的样本序号与最后时刻
+        qint64 layerNextSequence = 0;
+        qint64 layerLastTime = 0;
+        // 映射结果复用缓冲，预热后每帧不再分配
+        QVector<QPointF> mappedPoints;
+        // 时间相对坐标下的增量路径缓存
+        LoadPathCache pathCache;
+    };
+
+    const SeriesData &primarySeries() const { return m_model->seriesAt(0); }
+    void attachModel(LoadTimelineModel *model);
+    void detachModel();
+    // 按模型的序列列表增删绘制状态，保留仍存在的序列的缓存
+    void syncSeriesViews();
+    // 模型的保留窗口长于本控件的时间窗口（与更宽的视图共用模型）
+    bool sharedWindow() const { return m_model->timeWindowSeconds() > m_renderer.timeWindowSeconds(); }
+    // 时间窗口内原始样本的最小/最大值；无样本时返回 false
+    bool visibleExtrema(const SeriesData &series, qint64 windowStartMs, double &minValue, double &maxValue) const;
+
     QRectF chartRect() const;
     qreal uiScale() const;
-    qreal scaledMargin() const;
-    void pruneOutdatedSamples();
-    QPainterPath buildPath(const QVector<QPointF> &points) const;
-    QVector<QPointF> mapSamplesToPoints() const;
-    QColor colorForLoad(double value) const;
-    void drawAxis(QPainter &painter, const QRectF &area, qreal scale);
-    void drawThresholdZones(QPainter &painter, const QRectF &area);
-    void drawCurrentValueLabel(QPainter &painter, const QPointF &point, double value, qreal scale);
-
-    int m_timeWindowSeconds = 60;
-    int m_tickIntervalSeconds = 10;
+    // 汇总桶按绝对时间像素列归并为极值点（时间先后顺序）追加到 times/values，跳过早于 windowStartMs 的桶；
+    // includeOpen 为假时跳过第 0 层仍在接收样本的最新桶
+    void gatherTierPoints(const SeriesData &series, qint64 windowStartMs, QVector<qint64> &times,
+                          QVector<double> &values, bool includeOpen) const;
+    void syncTierPaths(const SeriesData &series, SeriesView &view, const LoadPathCache::Geometry &geometry);
+    // 自动量程：窗口内数据范围加留白与取整后的目标范围，无数据时返回 false
+    bool autoScaleTarget(double &minValue, double &maxValue);
+    // 每帧开始时调用：目标变化时重新开始过渡，按限速节奏把显示范围推向目标
+    void updateAutoScale();
+    void setDisplayedLoadRange(double minValue, double maxValue);
+    void scheduleRepaint();
+    // 本拍是否已满足 maxFrameRate 的最小帧间隔（容差半拍）
+    bool frameDue(double tickIntervalMs) const;
+    // 映射时间窗口内的样本，结果写入序列的复用缓冲，引用在下次映射同一序列前有效
+    const QVector<QPointF> &mapSamplesToPoints(const SeriesData &series, SeriesView &view, double nowMs) const;
+    void invalidateBackground();
+    void acquireBackground(qreal dpr, qreal scale);
+    void invalidateCurveLayer();
+    void paintContent(QPainter &painter);
+    void paintCachedCurves(QPainter &painter, qreal scale);
+    void paintScrollBlitCurve(QPainter &painter, qreal dpr, qreal scale);
+    // 向曲线贴图描边：分区着色时在阈值穿越处切分，按分区颜色描边
+    void strokeLayerCurve(QPainter &painter, const QVector<QPointF> &points, const QColor &color, const QRectF &area,
+                          qreal scale) const;
+    void paintAsyncCurves(QPainter &painter, qreal dpr, qreal scale);
+    void submitAsyncSnapshot(qreal dpr, qreal scale);
+    LoadRenderStats *statsSink() const;
+    void updateStatsTimer();
+    void publishRenderStats();
+    void drawDebugOverlay(QPainter &painter, qreal scale);
+    bool historyActive() const;
+    void setHistoryRangeMs(qint64 startMs, qint64 endMs);
+    void paintHistoryCurve(QPainter &painter, qreal scale);
+    // 悬停检视：按光标位置查找最近样本并只重绘新旧叠加层覆盖的区域
+    void updateHover(const QPointF &position, bool inside);
+    // 以上一帧的时刻与几何二分查找光标附近的样本，填充 m_hover；没有可检视的样本时返回 false
+    bool locateHover();
+    // 十字线、标记点与提示框覆盖的区域（控件坐标）
+    QRegion hoverRegion() const;
+    void drawHoverOverlay(QPainter &painter) const;
+    // 标注层：查询与时间窗口相交的标注，按颜色合并填充与描边，图表区域外裁剪
+    void drawAnnotations(QPainter &painter, qreal scale);
+
+    // 外观属性与绘制逻辑
+    LoadTimelineRenderer m_renderer;
+    // 时间源与本帧时刻（paintEvent 开始时读取一次）
+    std::shared_ptr<LoadClock> m_clock = LoadClock::systemClock();
+    qint64 m_frameNowMs = 0;
+    // 抽稀极值收集缓冲（映射前整批收集）
+    mutable QVector<qint64> m_gatherTimes;
+    mutable QVector<double> m_gatherValues;
+    bool m_scrollBlitEnabled = false;
+    bool m_zoneColoredCurve = false;
+    int m_maxFrameRate = 60;
+    // 属性设置的纵轴范围；未启用自动量程时即显示范围
     double m_loadMin = 0.0;
     double m_loadMax = 100.0;
-    double m_highThreshold = 80.0;
-    double m_mediumThreshold = 50.0;
-    QColor m_gradientStart = QColor(240, 248, 255);
-    QColor m_gradientEnd = QColor(210, 228, 255);
-    bool m_gridVisible = true;
-    bool m_smoothingEnabled = true;
-    bool m_currentValueLabelVisible = true;
-
-    QVector<Sample> m_samples;
+    bool m_autoScaleEnabled = false;
+    double m_autoScalePadding = 0.05;
+    bool m_autoScaleNiceRange = true;
+    int m_autoScaleAnimationMs = 300;
+    // 自动量程过渡：起点范围、目标范围、开始时刻与上次调整时刻（帧时刻）
+    bool m_autoScaleHasTarget = false;
+    double m_autoScaleFromMin = 0.0;
+    double m_autoScaleFromMax = 0.0;
+    double m_autoScaleTargetMin = 0.0;
+    double m_autoScaleTargetMax = 0.0;
+    qint64 m_autoScaleStartMs = 0;
+    qint64 m_autoScaleLastStepMs = std::numeric_limits<qint64>::min() / 2;
+    bool m_historyMode = false;
+    bool m_instrumentationEnabled = false;
+    bool m_debugOverlayVisible = false;
+
+    // 数据模型（私有模型由 m_ownedModel 持有）与各序列的绘制状态
+    LoadTimelineModel *m_model = nullptr;
+    std::unique_ptr<LoadTimelineModel> m_ownedModel;
+    std::vector<std::unique_ptr<SeriesView>> m_seriesViews;
+
+    // 静态背景（按设备像素比生成），属性、尺寸或 DPR 变化时失效；外观相同的控件共用同一张
+    std::shared_ptr<const QPixmap> m_background;
+    bool m_backgroundDirty = true;
+
+    // 滚动贴图模式下的曲线层：记录生成时的参考时间
+    QPixmap m_curveLayer;
+    double m_curveLayerTime = 0.0;
+    bool m_curveLayerDirty = true;
+
+    // 异步绘制：数据或外观变化后才提交新快照
+    std::unique_ptr<LoadAsyncRenderer> m_asyncRenderer;
+    bool m_asyncDirty = true;
+    quint64 m_asyncSubmittedSamples = 0;
+
+    // 重绘合并：等待帧调度器下一拍派发，距上次绘制的耗时用于 maxFrameRate 限速
+    bool m_framePending = false;
+    QElapsedTimer m_lastPaintTimer;
+
+    // 历史回看：归档、可见时间范围与拖动平移状态
+    std::unique_ptr<LoadSessionArchive> m_historyArchive;
+    qint64 m_historyStartMs = 0;
+    qint64 m_historyEndMs = 0;
+    bool m_panning = false;
+    qreal m_panAnchorX = 0.0;
+    qint64 m_panStartMs = 0;
+    qint64 m_panEndMs = 0;
+
+    // 标注区间索引与绘制复用缓冲（按颜色分批，预热后每帧不再分配）
+    struct AnnotationBatch {
+        QColor color;
+        QVector<QRectF> spans;
+        QVector<QLineF> marks;
+        int lastMarkColumn = 0;
+        bool hasMark = false;
+    };
+    bool m_annotationsVisible = true;
+    QVector<const LoadAnnotationIndex::Annotation *> m_visibleAnnotations;
+    QVector<AnnotationBatch> m_annotationBatches;
+
+    // 悬停检视：光标位置、命中的样本及其图表坐标、提示框内容与位置
+    struct HoverState {
+        bool visible = false;
+        QPointF position;
+        int seriesId = PrimarySeriesId;
+        qint64 timeMs = 0;
+        double value = 0.0;
+        bool rollup = false;
+        LoadZone zone = LowLoad;
+        QPointF point;
+        QStringList lines;
+        QRectF tooltipRect;
+    };
+    bool m_hoverInspectionEnabled = true;
+    HoverState m_hover;
+    // 检视期间上一帧的完整内容（不含叠加层）：光标移动只从中补回旧叠加层覆盖的区域，不重绘曲线
+    QPixmap m_hoverFrame;
+
+    // 运行统计（在 const 绘制辅助函数中累加阶段耗时）
+    mutable LoadRenderStats m_renderStats;
+    quint64 m_repaintsCoalesced = 0;
+    QTimer m_statsTimer;
+    QElapsedTimer m_statsClock;
+    quint64 m_statsFramesMark = 0;
+    quint64 m_statsSamplesMark = 0;
 };
 
@@ -0,0 +1,42 @@
+#include "LoadWindowExtrema.h"
+
+#include <cmath>
+
+void LoadWindowExtrema::clear() {
+    m_min.entries.resize(0);
+    m_min.head = 0;
+    m_max.entries.resize(0);
+    m_max.head = 0;
+}
+
+void LoadWindowExtrema::append(qint64 sequence, double value) {
+    if (!std::isfinite(value)) return;
+    // 新样本比尾部候选更晚离开窗口，尾部不优于它的候选永远不会再成为极值
+    push(m_min, sequence, value, [](double back, double incoming) { return back >= incoming; });
+    push(m_max, sequence, value, [](double back, double incoming) { return back <= incoming; });
+}
+
+void LoadWindowExtrema::dropBefore(qint64 firstSequence) {
+    popBefore(m_min, firstSequence);
+    popBefore(m_max, firstSequence);
+}
+
+template <typename Dominates>
+void LoadWindowExtrema::push(Deque &deque, qint64 sequence, double value, Dominates dominates) {
+    QVector<Entry> &entries = deque.entries;
+    while (entries.size() > deque.head && dominates(entries.constLast().value, value)) {
+        entries.removeLast();
+    }
+    // 已移出的头部超过一半时整体前移，移动开销由此前的移出均摊
+    if (deque.head > 0 && deque.head * 2 >= entries.size()) {
+        entries.remove(0, deque.head);
+        deque.head = 0;
+    }
+    entries.append({sequence, value});
+}
+
+void LoadWindowExtrema::popBefore(Deque &deque, qint64 firstSequence) {
+    while (deque.head < deque.entries.size() && deque.entries.at(deque.head).sequence < firstSequence) {
+        ++deque.head;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+// 滑动窗口极值：单调双端队列分别维护窗口内的最小值与最大值候选，
+// 追加与按序号移出的均摊开销为 O(1)，查询为 O(1)，与窗口内样本数无关。
+// 样本以缓冲区序号标识，只能从尾部追加、从头部移出；非有限值不参与统计。
+class LoadWindowExtrema {
+public:
+    void clear();
+    // 尾部追加序号为 sequence 的样本（序号须递增）
+    void append(qint64 sequence, double value);
+    // 移出序号早于 firstSequence 的样本
+    void dropBefore(qint64 firstSequence);
+
+    bool isEmpty() const { return m_min.head == m_min.entries.size(); }
+    // 窗口为空时无意义，调用前先判断 isEmpty()
+    double min() const { return m_min.entries.at(m_min.head).value; }
+    double max() const { return m_max.entries.at(m_max.head).value; }
+
+private:
+    struct Entry {
+        qint64 sequence = 0;
+        double value = 0.0;
+    };
+
+    // 队列自头到尾序号递增、数值单调；头部前移后延迟压缩，容量预热后不再分配
+    struct Deque {
+        QVector<Entry> entries;
+        qsizetype head = 0;
+    };
+
+    template <typename Dominates>
+    static void push(Deque &deque, qint64 sequence, double value, Dominates dominates);
+    static void popBefore(Deque &deque, qint64 firstSequence);
+
+    Deque m_min;
+    Deque m_max;
+};
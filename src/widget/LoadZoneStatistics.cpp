@@ -0,0 +1,97 @@
+#include "LoadZoneStatistics.h"
+#include "LoadSampleBuffer.h"
+
+double LoadZoneStatistics::Dwell::fraction(int zone) const {
+    const qint64 total = totalMs();
+    if (total <= 0 || zone < 0 || zone >= ZoneCount) return 0.0;
+    return static_cast<double>(zoneMs[zone]) / total;
+}
+
+void LoadZoneStatistics::setThresholds(double medium, double high) {
+    m_mediumThreshold = medium;
+    m_highThreshold = high;
+}
+
+int LoadZoneStatistics::zoneFor(double value) const {
+    // 与 colorForLoad() 的分区规则保持一致
+    if (value >= m_highThreshold) return 2;
+    if (value >= m_mediumThreshold) return 1;
+    return 0;
+}
+
+void LoadZoneStatistics::reset() {
+    m_dwell = Dwell();
+}
+
+void LoadZoneStatistics::sampleAppended(const LoadSampleBuffer &buffer) {
+    const qsizetype size = buffer.size();
+    if (size < 2) return;
+    const qint64 span = qMax<qint64>(0, buffer.timeAt(size - 1) - buffer.timeAt(size - 2));
+    m_dwell.zoneMs[zoneFor(buffer.valueAt(size - 2))] += span;
+}
+
+void LoadZoneStatistics::samplesRemoving(const LoadSampleBuffer &buffer, qsizetype count) {
+    // 每个离开的样本带走它与后继样本之间的时长
+    const qsizetype last = qMin(count, buffer.size() - 1);
+    for (qsizetype i = 0; i < last; ++i) {
+        const qint64 span = qMax<qint64>(0, buffer.timeAt(i + 1) - buffer.timeAt(i));
+        m_dwell.zoneMs[zoneFor(buffer.valueAt(i))] -= span;
+    }
+    if (count >= buffer.size()) {
+        m_dwell = Dwell();
+    }
+}
+
+void LoadZoneStatistics::recompute(const LoadSampleBuffer &buffer) {
+    m_dwell = Dwell();
+    for (qsizetype i = 1; i < buffer.size(); ++i) {
+        const qint64 span = qMax<qint64>(0, buffer.timeAt(i) - buffer.timeAt(i - 1));
+        m_dwell.zoneMs[zoneFor(buffer.valueAt(i - 1))] += span;
+    }
+}
+
+void LoadZoneTracker::reset() {
+    m_zone = -1;
+    m_previousZone = -1;
+    m_candidate = -1;
+    m_candidateSince = 0;
+}
+
+int LoadZoneTracker::classify(double value, double medium, double high) const {
+    if (m_zone < 0) {
+        if (value >= high) return 2;
+        if (value >= medium) return 1;
+        return 0;
+    }
+
+    // 滞回：离开当前分区向下需低于阈值减滞回量
+    const double mediumDown = m_zone >= 1 ? medium - m_hysteresis : medium;
+    const double highDown = m_zone >= 2 ? high - m_hysteresis : high;
+    if (value >= highDown) return 2;
+    if (value >= mediumDown) return 1;
+    return 0;
+}
+
+bool LoadZoneTracker::feed(qint64 timeMs, double value, double medium, double high) {
+    const int zone = classify(value, medium, high);
+    if (m_zone < 0) {
+        m_zone = zone;
+        m_candidate = -1;
+        return false;
+    }
+    if (zone == m_zone) {
+        m_candidate = -1;
+        return false;
+    }
+
+    if (zone != m_candidate) {
+        m_candidate = zone;
+        m_candidateSince = timeMs;
+    }
+    if (timeMs - m_candidateSince < m_debounceMs) return false;
+
+    m_previousZone = m_zone;
+    m_zone = zone;
+    m_candidate = -1;
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QtGlobal>
+
+class LoadSampleBuffer;
+
+// 高/中/低负荷驻留时长统计：随样本进入与离开窗口以 O(1) 增量维护。
+// 相邻两样本之间的时长计入前一样本所在分区；分区编号 0/1/2 分别为低/中/高。
+class LoadZoneStatistics {
+public:
+    static constexpr int ZoneCount = 3;
+
+    // 各分区驻留时长（毫秒）
+    struct Dwell {
+        qint64 zoneMs[ZoneCount] = {0, 0, 0};
+
+        qint64 lowMs() const { return zoneMs[0]; }
+        qint64 mediumMs() const { return zoneMs[1]; }
+        qint64 highMs() const { return zoneMs[2]; }
+        qint64 totalMs() const { return zoneMs[0] + zoneMs[1] + zoneMs[2]; }
+        // 分区占比（0~1），总时长为 0 时返回 0
+        double fraction(int zone) const;
+    };
+
+    void setThresholds(double medium, double high);
+    int zoneFor(double value) const;
+
+    void reset();
+    // 缓冲区末尾追加一个样本后调用
+    void sampleAppended(const LoadSampleBuffer &buffer);
+    // 缓冲区头部即将丢弃 count 个样本前调用
+    void samplesRemoving(const LoadSampleBuffer &buffer, qsizetype count);
+    // 阈值变化等情况下全量重算
+    void recompute(const LoadSampleBuffer &buffer);
+
+    const Dwell &dwell() const { return m_dwell; }
+
+private:
+    double m_mediumThreshold = 50.0;
+    double m_highThreshold = 80.0;
+    Dwell m_dwell;
+};
+
+// 分区切换判定：带滞回与去抖，避免阈值附近抖动产生大量切换。
+// 上升需达到阈值，下降需低于阈值减滞回量；候选分区持续 debounceMs 后才确认切换。
+class LoadZoneTracker {
+public:
+    void setHysteresis(double hysteresis) { m_hysteresis = qMax(0.0, hysteresis); }
+    void setDebounceMs(qint64 debounceMs) { m_debounceMs = qMax<qint64>(0, debounceMs); }
+    void reset();
+
+    // 输入样本，分区确认切换时返回 true，previousZone() 为切换前分区
+    bool feed(qint64 timeMs, double value, double medium, double high);
+
+    bool hasZone() const { return m_zone >= 0; }
+    int zone() const { return m_zone; }
+    int previousZone() const { return m_previousZone; }
+
+private:
+    int classify(double value, double medium, double high) const;
+
+    double m_hysteresis = 0.0;
+    qint64 m_debounceMs = 0;
+    int m_zone = -1;
+    int m_previousZone = -1;
+    int m_candidate = -1;
+    qint64 m_candidateSince = 0;
+};
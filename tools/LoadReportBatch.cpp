@@ -0,0 +1,252 @@
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFont>
+#include <QGuiApplication>
+#include <QHash>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPageSize>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QSet>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include "widget/LoadSessionArchive.h"
+#include "widget/LoadTimelineRenderer.h"
+
+#include <atomic>
+
+// 批量报表工具：把会话归档（.mlsa）渲染为 PNG 或 PDF 负荷曲线。
+// 每个归档是一个独立任务：各自映射文件、复制绘制器并绘制到自己的 QImage/QPdfWriter，
+// 任务之间没有共享的可变状态，吞吐随核心数近似线性增长。
+
+namespace {
+
+struct ReportJob {
+    QString inputPath;
+    QString outputPath;
+    QString error;
+    bool ok = false;
+};
+
+QTextStream &out() {
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+QTextStream &err() {
+    static QTextStream stream(stderr);
+    return stream;
+}
+
+// 展开命令行参数：目录取其中的 *.mlsa；同一文件被多次指定（直接列出或经目录展开）时只保留一次
+QStringList collectArchives(const QStringList &arguments) {
+    QStringList paths;
+    QSet<QString> seen;
+    auto add = [&](const QFileInfo &info) {
+        const QString path = info.absoluteFilePath();
+        if (!seen.contains(path)) {
+            seen.insert(path);
+            paths.append(path);
+        }
+    };
+    for (const QString &argument : arguments) {
+        const QFileInfo info(argument);
+        if (info.isDir()) {
+            const QFileInfoList entries =
+                QDir(argument).entryInfoList({QStringLiteral("*.mlsa")}, QDir::Files, QDir::Name);
+            for (const QFileInfo &entry : entries) {
+                add(entry);
+            }
+        } else {
+            add(info);
+        }
+    }
+    return paths;
+}
+
+// 输出文件名（不含扩展名）：默认取归档文件名；不同目录下的同名归档改为“所在目录名_文件名”，
+// 仍重复时依次追加 -2、-3…。按不区分大小写比较，避免在 Windows 上互相覆盖；结果与任务顺序一一对应
+QStringList outputBaseNames(const QStringList &paths) {
+    QHash<QString, int> baseCounts;
+    for (const QString &path : paths) {
+        ++baseCounts[QFileInfo(path).completeBaseName().toLower()];
+    }
+    QStringList names;
+    QSet<QString> used;
+    for (const QString &path : paths) {
+        const QFileInfo info(path);
+        QString name = info.completeBaseName();
+        if (baseCounts.value(name.toLower()) > 1) {
+            name = info.dir().dirName() + QLatin1Char('_') + name;
+        }
+        QString candidate = name;
+        for (int suffix = 2; used.contains(candidate.toLower()); ++suffix) {
+            candidate = name + QLatin1Char('-') + QString::number(suffix);
+        }
+        used.insert(candidate.toLower());
+        names.append(candidate);
+    }
+    return names;
+}
+
+bool renderPng(ReportJob &job, LoadTimelineRenderer &renderer, const LoadSessionArchive &archive,
+               const QSize &size, const QFont &font, const QColor &color) {
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    {
+        QPainter painter(&image);
+        painter.setFont(font);
+        renderer.renderArchive(painter, QRectF(QPointF(0, 0), QSizeF(size)), archive, color);
+    }
+    if (!image.save(job.outputPath, "PNG")) {
+        job.error = QStringLiteral("cannot write %1").arg(job.outputPath);
+        return false;
+    }
+    return true;
+}
+
+bool renderPdf(ReportJob &job, LoadTimelineRenderer &renderer, const LoadSessionArchive &archive,
+               const QSize &size, const QFont &font, const QColor &color) {
+    // 以 96 dpi 设定页面，使绘制坐标与 PNG 的像素尺寸一致
+    QPdfWriter writer(job.outputPath);
+    writer.setResolution(96);
+    writer.setPageSize(QPageSize(QSizeF(size) * 72.0 / 96.0, QPageSize::Point));
+    writer.setPageMargins(QMarginsF(0, 0, 0, 0));
+
+    QPainter painter;
+    if (!painter.begin(&writer)) {
+        job.error = QStringLiteral("cannot write %1").arg(job.outputPath);
+        return false;
+    }
+    painter.setFont(font);
+    const QRectF bounds(0, 0, painter.device()->width(), painter.device()->height());
+    renderer.renderArchive(painter, bounds, archive, color);
+    return painter.end();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    // 默认使用 offscreen 平台，无需显示器即可运行
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Render session archives to PNG/PDF load charts in parallel"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("archives"), QStringLiteral("Session archive files or directories."),
+                                 QStringLiteral("archives..."));
+    QCommandLineOption outputOption({QStringLiteral("o"), QStringLiteral("output-dir")},
+                                    QStringLiteral("Output directory."), QStringLiteral("dir"), QStringLiteral("."));
+    QCommandLineOption formatOption(QStringLiteral("format"), QStringLiteral("Output format: png or pdf."),
+                                    QStringLiteral("format"), QStringLiteral("png"));
+    QCommandLineOption widthOption(QStringLiteral("width"), QStringLiteral("Chart width in pixels."),
+                                   QStringLiteral("px"), QStringLiteral("1280"));
+    QCommandLineOption heightOption(QStringLiteral("height"), QStringLiteral("Chart height in pixels."),
+                                    QStringLiteral("px"), QStringLiteral("480"));
+    QCommandLineOption jobsOption({QStringLiteral("j"), QStringLiteral("jobs")},
+                                  QStringLiteral("Worker threads (default: all cores)."), QStringLiteral("count"),
+                                  QString::number(QThread::idealThreadCount()));
+    QCommandLineOption loadMinOption(QStringLiteral("load-min"), QStringLiteral("Y axis minimum."),
+                                     QStringLiteral("value"), QStringLiteral("0"));
+    QCommandLineOption loadMaxOption(QStringLiteral("load-max"), QStringLiteral("Y axis maximum."),
+                                     QStringLiteral("value"), QStringLiteral("100"));
+    QCommandLineOption mediumOption(QStringLiteral("medium"), QStringLiteral("Medium load threshold."),
+                                    QStringLiteral("value"), QStringLiteral("50"));
+    QCommandLineOption highOption(QStringLiteral("high"), QStringLiteral("High load threshold."),
+                                  QStringLiteral("value"), QStringLiteral("80"));
+    QCommandLineOption noGridOption(QStringLiteral("no-grid"), QStringLiteral("Hide grid lines."));
+    QCommandLineOption noSmoothingOption(QStringLiteral("no-smoothing"), QStringLiteral("Draw straight segments."));
+    QCommandLineOption noLabelOption(QStringLiteral("no-label"), QStringLiteral("Hide the last-value label."));
+    parser.addOptions({outputOption, formatOption, widthOption, heightOption, jobsOption, loadMinOption,
+                       loadMaxOption, mediumOption, highOption, noGridOption, noSmoothingOption, noLabelOption});
+    parser.process(app);
+
+    const QString format = parser.value(formatOption).toLower();
+    if (format != QLatin1String("png") && format != QLatin1String("pdf")) {
+        err() << "unsupported format: " << format << '\n';
+        return 2;
+    }
+    const QSize size(qMax(64, parser.value(widthOption).toInt()), qMax(64, parser.value(heightOption).toInt()));
+    const int threads = qMax(1, parser.value(jobsOption).toInt());
+
+    // 基准绘制器只在主线程配置，任务内各自复制
+    LoadTimelineRenderer baseRenderer;
+    baseRenderer.setLoadMin(parser.value(loadMinOption).toDouble());
+    baseRenderer.setLoadMax(parser.value(loadMaxOption).toDouble());
+    baseRenderer.setMediumThreshold(parser.value(mediumOption).toDouble());
+    baseRenderer.setHighThreshold(parser.value(highOption).toDouble());
+    baseRenderer.setGridVisible(!parser.isSet(noGridOption));
+    baseRenderer.setSmoothingEnabled(!parser.isSet(noSmoothingOption));
+    baseRenderer.setCurrentValueLabelVisible(!parser.isSet(noLabelOption));
+    const QFont font = QGuiApplication::font();
+    const QColor color(0, 96, 180);
+
+    const QDir outputDir(parser.value(outputOption));
+    if (!outputDir.exists() && !QDir().mkpath(outputDir.absolutePath())) {
+        err() << "cannot create output directory: " << outputDir.absolutePath() << '\n';
+        return 2;
+    }
+
+    const QStringList archives = collectArchives(parser.positionalArguments());
+    const QStringList outputNames = outputBaseNames(archives);
+    QVector<ReportJob> jobs;
+    for (qsizetype i = 0; i < archives.size(); ++i) {
+        ReportJob job;
+        job.inputPath = archives.at(i);
+        job.outputPath = outputDir.filePath(outputNames.at(i) + QLatin1Char('.') + format);
+        jobs.append(job);
+    }
+    if (jobs.isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    std::atomic<qint64> sampleTotal{0};
+
+    QElapsedTimer timer;
+    timer.start();
+    QtConcurrent::blockingMap(&pool, jobs, [&](ReportJob &job) {
+        LoadSessionArchive archive;
+        if (!archive.open(job.inputPath)) {
+            job.error = QStringLiteral("cannot open archive %1").arg(job.inputPath);
+            return;
+        }
+        LoadTimelineRenderer renderer = baseRenderer;
+        job.ok = format == QLatin1String("pdf") ? renderPdf(job, renderer, archive, size, font, color)
+                                                : renderPng(job, renderer, archive, size, font, color);
+        sampleTotal += archive.sampleCount();
+    });
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    int failed = 0;
+    for (const ReportJob &job : jobs) {
+        if (!job.ok) {
+            ++failed;
+            err() << job.error << '\n';
+        }
+    }
+    err().flush();
+
+    const double seconds = elapsedNs / 1e9;
+    QJsonObject summary;
+    summary[QStringLiteral("reports")] = jobs.size() - failed;
+    summary[QStringLiteral("failed")] = failed;
+    summary[QStringLiteral("threads")] = threads;
+    summary[QStringLiteral("format")] = format;
+    summary[QStringLiteral("samples")] = double(sampleTotal.load());
+    summary[QStringLiteral("seconds")] = seconds;
+    summary[QStringLiteral("reportsPerSecond")] = seconds > 0 ? (jobs.size() - failed) / seconds : 0.0;
+    out() << QJsonDocument(summary).toJson(QJsonDocument::Compact) << '\n';
+    return failed == 0 ? 0 : 1;
+}